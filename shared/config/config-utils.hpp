@@ -4,6 +4,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <chrono>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -29,28 +31,42 @@ class Configuration {
     // Returns the config path for the given mod info
     static std::string getConfigFilePath(const modloader::ModInfo& info);
     const modloader::ModInfo info;
+    // After a Reload, string values reference the loaded file's mapping, which lives until the next Reload or destruction.
+    // Values taken out of config must be deep copied (ex: CopyFrom with copyConstStrings) to outlive it.
     ConfigDocument config;
     bool readJson = false;
-    Configuration(const modloader::ModInfo& info_) : info(info_) {
-        filePath = Configuration::getConfigFilePath(info_);
-    }
-    Configuration(Configuration&& other) : info(std::move(other.info)), filePath(std::move(other.filePath)) {
-        config.Swap(other.config);
-    }
-    Configuration(const Configuration& other) : info(other.info), filePath(other.filePath) {
-        config.CopyFrom(other.config, config.GetAllocator());
-    }
+    // How long Write waits for further writes before writing to disk
+    std::chrono::milliseconds writeDelay{ 500 };
+    Configuration(const modloader::ModInfo& info_);
+    Configuration(Configuration&& other);
+    Configuration(const Configuration& other);
+    // Writes any pending config before destruction
+    ~Configuration();
     // Loads JSON config
     void Load();
-    // Reloads JSON config
+    // Reloads JSON config, writing any pending config first.
+    // The file is memory mapped and parsed in situ into an arena that is reused by later reloads,
+    // so string values point into the mapping and are invalidated by the next Reload or destruction.
+    // If the file fails to parse, the current config is kept.
     void Reload();
-    // Writes JSON config
+    // Writes JSON config on the writer thread shared by every Configuration.
+    // The config is copied immediately, and written once no further writes were requested for writeDelay,
+    // so writes in quick succession (ex: from a slider) only serialize and write the last one.
+    // The file is replaced atomically, so it is never left partially written.
     void Write();
+    // Writes any pending config immediately, blocking until it is on disk
+    void Flush();
+    // Returns the number of writes skipped, either replaced by a later write or identical to what was last written
+    std::size_t SkippedWrites() const;
 
    private:
+    struct AsyncWriter;
+    struct LoadArenas;
     static std::optional<std::string> configDir;
     bool ensureObject();
     std::string filePath;
+    std::unique_ptr<AsyncWriter> writer;
+    std::unique_ptr<LoadArenas> arenas;
 };
 
 // SETTINGS
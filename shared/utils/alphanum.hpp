@@ -26,10 +26,16 @@
 /* $Header: /code/doj/alphanum.hpp,v 1.3 2008/01/28 23:06:47 doj Exp $ */
 // From: http://www.davekoelle.com/files/alphanum.hpp
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <functional>
+#include <numeric>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #ifdef ALPHANUM_LOCALE
 #include <cctype>
@@ -282,6 +288,67 @@ struct alphanum_less {
     }
 };
 
+////////////////////////////////////////////////////////////////////////////
+
+/**
+   Transform s into a key which compares (with std::string's operator<,
+   a memcmp) in the same order as alphanum_comp() compares the strings,
+   for ASCII digits and unsigned chars. Computing the key once per
+   string avoids re-scanning the digit runs on every comparison.
+
+   A digit run becomes a marker byte, its length without leading zeros
+   and its digits, so that longer numbers sort after shorter ones and
+   digits sort before any other character. Other characters are shifted
+   up to stay above the marker.
+ */
+inline std::string alphanum_key(std::string_view s) {
+    std::string key;
+    key.reserve(s.size() + 4);
+    for (std::size_t i = 0; i < s.size();) {
+        if (alphanum_isdigit(s[i])) {
+            std::size_t end = i;
+            while (end < s.size() && alphanum_isdigit(s[end])) ++end;
+            // leading zeros do not change the value, as in alphanum_impl()
+            while (i + 1 < end && s[i] == '0') ++i;
+            key += '\x01';
+            key += static_cast<char>(std::min<std::size_t>(end - i, 0xFF));
+            key.append(s.data() + i, end - i);
+            i = end;
+        } else {
+            const unsigned char c = s[i++];
+            if (c < 0xFE) {
+                key += static_cast<char>(c + 1);
+            } else {
+                key += '\xFF';
+                key += static_cast<char>(c - 0xFE);
+            }
+        }
+    }
+    return key;
+}
+
+/**
+   Sort items in place with the "Alphanum Algorithm", computing the key
+   of each item once instead of comparing the strings on every step.
+
+   @param proj returns the string of an item, convertible to std::string_view
+ */
+template <class T, class Proj = std::identity>
+void alphanum_sort(std::span<T> items, Proj proj = {}) {
+    std::vector<std::string> keys;
+    keys.reserve(items.size());
+    for (auto const& item : items) keys.push_back(alphanum_key(std::string_view(std::invoke(proj, item))));
+
+    std::vector<std::uint32_t> order(items.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](std::uint32_t a, std::uint32_t b) { return keys[a] < keys[b]; });
+
+    std::vector<T> sorted;
+    sorted.reserve(items.size());
+    for (auto i : order) sorted.push_back(std::move(items[i]));
+    std::move(sorted.begin(), sorted.end(), items.begin());
+}
+
 }  // namespace doj
 
 #ifdef TESTMAIN
@@ -3,12 +3,123 @@
 #include "capstone/shared/capstone/capstone.h"
 #include "capstone/shared/platform.h"
 #include <array>
+#include <memory>
 #include <tuple>
 #include <optional>
+#include <vector>
 
 namespace cs {
 csh getHandle();
 
+/// @brief A minimal AArch64 decoder for the few instruction classes the search helpers below care about.
+/// Decoding a word is a handful of mask compares, so searches only need capstone for words this cannot classify.
+namespace decode {
+    enum struct Kind : uint8_t {
+        /// @brief Not decoded, but may be an ADD/LDR form (or SIMD) that capstone would report. Use capstone if it matters.
+        Unknown,
+        /// @brief Definitely none of the instructions below.
+        Other,
+        Ret,
+        B,
+        /// @brief B.cond, which capstone reports as ARM64_INS_B.
+        BCond,
+        Bl,
+        Br,
+        Blr,
+        Adr,
+        Adrp,
+        /// @brief ADD (immediate), excluding the MOV (to/from SP) alias.
+        AddImm,
+        /// @brief LDR (immediate, unsigned offset) into a general purpose register.
+        LdrImm,
+    };
+
+    struct Insn {
+        Kind kind = Kind::Other;
+        /// @brief Destination register, or the branch register for BR/BLR/RET.
+        arm64_reg rd = ARM64_REG_INVALID;
+        /// @brief Source/base register for ADD/LDR.
+        arm64_reg rn = ARM64_REG_INVALID;
+        /// @brief Absolute target for B/B.cond/BL/ADR/ADRP, immediate for ADD, byte offset for LDR.
+        int64_t imm = 0;
+    };
+
+    constexpr int64_t signExtend(uint64_t value, unsigned bits) {
+        auto const shift = 64 - bits;
+        return static_cast<int64_t>(value << shift) >> shift;
+    }
+
+    /// @brief Converts an encoded register number to capstone's register enum.
+    /// Register 31 is SP/WSP where the encoding allows it, XZR/WZR otherwise.
+    constexpr arm64_reg reg(uint32_t n, bool is64, bool sp) {
+        if (n == 31) {
+            if (sp) return is64 ? ARM64_REG_SP : ARM64_REG_WSP;
+            return is64 ? ARM64_REG_XZR : ARM64_REG_WZR;
+        }
+        if (!is64) return static_cast<arm64_reg>(ARM64_REG_W0 + n);
+        // X29 and X30 are not contiguous with the other X registers in capstone
+        if (n == 29) return ARM64_REG_X29;
+        if (n == 30) return ARM64_REG_X30;
+        return static_cast<arm64_reg>(ARM64_REG_X0 + n);
+    }
+
+    /// @brief Decodes a single instruction word, located at pc.
+    constexpr Insn decode(uint32_t word, uint64_t pc) {
+        uint32_t const rd = word & 0x1F;
+        uint32_t const rn = (word >> 5) & 0x1F;
+
+        // B/BL: op 00101, imm26
+        if ((word & 0x7C000000) == 0x14000000) {
+            auto target = static_cast<int64_t>(pc) + signExtend(static_cast<uint64_t>(word & 0x03FFFFFF) << 2, 28);
+            return { (word & 0x80000000) ? Kind::Bl : Kind::B, ARM64_REG_INVALID, ARM64_REG_INVALID, target };
+        }
+        // B.cond: 0101010 0 imm19 0 cond
+        if ((word & 0xFF000010) == 0x54000000) {
+            auto target = static_cast<int64_t>(pc) + signExtend(static_cast<uint64_t>((word >> 5) & 0x7FFFF) << 2, 21);
+            return { Kind::BCond, ARM64_REG_INVALID, ARM64_REG_INVALID, target };
+        }
+        // BR/BLR/RET (register), without pointer authentication
+        switch (word & 0xFFFFFC1F) {
+            case 0xD61F0000:
+                return { Kind::Br, reg(rn, true, false) };
+            case 0xD63F0000:
+                return { Kind::Blr, reg(rn, true, false) };
+            case 0xD65F0000:
+                return { Kind::Ret, reg(rn, true, false) };
+            default:
+                break;
+        }
+        // ADR/ADRP: op immlo 10000 immhi Rd
+        if ((word & 0x1F000000) == 0x10000000) {
+            uint64_t const imm = (((word >> 5) & 0x7FFFF) << 2) | ((word >> 29) & 0x3);
+            if (word & 0x80000000) {
+                auto target = static_cast<int64_t>(pc & ~uint64_t(0xFFF)) + signExtend(imm << 12, 33);
+                return { Kind::Adrp, reg(rd, true, false), ARM64_REG_INVALID, target };
+            }
+            return { Kind::Adr, reg(rd, true, false), ARM64_REG_INVALID, static_cast<int64_t>(pc) + signExtend(imm, 21) };
+        }
+        // ADD (immediate): sf 0 0 100010 sh imm12 Rn Rd
+        if ((word & 0x7F800000) == 0x11000000) {
+            bool const is64 = word & 0x80000000;
+            int64_t const imm = static_cast<int64_t>((word >> 10) & 0xFFF) << ((word & 0x00400000) ? 12 : 0);
+            // add Rd, Rn, #0 with SP is disassembled as mov
+            if (imm == 0 && (rd == 31 || rn == 31)) return { Kind::Other };
+            return { Kind::AddImm, reg(rd, is64, true), reg(rn, is64, true), imm };
+        }
+        // LDR (immediate, unsigned offset): 1 sz 111 0 01 01 imm12 Rn Rt
+        if ((word & 0xBFC00000) == 0xB9400000) {
+            bool const is64 = word & 0x40000000;
+            int64_t const imm = static_cast<int64_t>((word >> 10) & 0xFFF) << (is64 ? 3 : 2);
+            return { Kind::LdrImm, reg(rd, is64, false), reg(rn, true, true), imm };
+        }
+        // Other loads/stores, other ADD encodings and SIMD/FP are left to capstone
+        if ((word & 0x0A000000) == 0x08000000 || (word & 0x1F000000) == 0x0B000000 || (word & 0x0E000000) == 0x0E000000) {
+            return { Kind::Unknown };
+        }
+        return { Kind::Other };
+    }
+}  // namespace decode
+
 uint32_t* readb(const uint32_t* addr);
 
 template<arm64_insn... args>
@@ -20,11 +131,30 @@ constexpr bool insnMatch(cs_insn* insn) {
 };
 
 struct AddrSearchPair {
-    AddrSearchPair(uint32_t const* addr_, uint32_t remSearchSize_) : addr(addr_), remSearchSize(remSearchSize_) {}
+    AddrSearchPair(uint32_t const* addr_, uint32_t remSearchSize_, bool cacheable_ = true) : addr(addr_), remSearchSize(remSearchSize_), cacheable(cacheable_) {}
     uint32_t const* addr;
     uint64_t remSearchSize;
+    /// @brief Whether addr is live code whose decoding may be cached, as opposed to a copy of it.
+    bool cacheable;
+};
+
+/// @brief A view of cached decoded instructions. Holds a reference to the stream, so it remains valid even if the cache is invalidated.
+struct DecodedRange {
+    std::shared_ptr<const std::vector<decode::Insn>> stream;
+    std::size_t offset = 0;
+    std::size_t count = 0;
+
+    decode::Insn const& operator[](std::size_t idx) const { return (*stream)[offset + idx]; }
 };
 
+/// @brief Returns the decoded instructions for count words starting at addr.
+/// Instructions are decoded once per function and cached, so repeated searches through the same code are array scans.
+/// A search starting partway into a cached function shares that function's stream.
+DecodedRange decoded(const uint32_t* addr, std::size_t count);
+
+/// @brief Drops any cached decoded instructions overlapping the provided range. Must be called whenever code is patched.
+void invalidateDecoded(const void* addr, std::size_t size);
+
 auto find_through_hooks(void const* hook, uint32_t initialSearchSize, auto&& func) {
     // First, check to see if we are hooked.
     auto const& logger = il2cpp_utils::Logger;
@@ -34,7 +164,7 @@ auto find_through_hooks(void const* hook, uint32_t initialSearchSize, auto&& fun
         uint32_t const* addr = hooks.front().original_data.data();
         uint32_t size = hooks.front().original_data.size() * sizeof(uint32_t);
         logger.debug("Hook found ({})! Original data: {} with size: {}", hooks.front().name, fmt::ptr(addr), size);
-        return func(cs::AddrSearchPair(addr, size), cs::AddrSearchPair(reinterpret_cast<uint32_t const*>(hook), initialSearchSize));
+        return func(cs::AddrSearchPair(addr, size, false), cs::AddrSearchPair(reinterpret_cast<uint32_t const*>(hook), initialSearchSize));
     }
     logger.debug("No hook found! Searching: {}, {}", fmt::ptr(hook), initialSearchSize);
     return func(cs::AddrSearchPair(reinterpret_cast<uint32_t const*>(hook), initialSearchSize));
@@ -219,6 +349,66 @@ auto findNth(const uint32_t* addr) {
     return (decltype(match(insn)))std::nullopt;
 }
 
+/// @brief Like findNth, but decodes with decode::decode instead of capstone.
+/// match and skip are called with the decoded instruction and its address.
+/// Cacheable pairs are read through the decoded instruction cache, see decoded.
+template<std::size_t sz, class F1, class F2>
+decltype(auto) findNthDecoded(std::array<AddrSearchPair, sz>& addrs, uint32_t nToRetOn, int retCount, F1&& match, F2&& skip) {
+    auto const& logger = il2cpp_utils::Logger;
+    using result_t = decltype(match(std::declval<decode::Insn const&>(), std::declval<uint32_t const*>()));
+
+    // Returns a value once the search is over
+    auto step = [&](decode::Insn const& insn, uint32_t const* addr) -> std::optional<result_t> {
+        if (insn.kind == decode::Kind::Ret) {
+            if (retCount == 0) {
+                logger.warn("Could not find: {} call at: {} within: {} rets! Found all of the rets first!", nToRetOn, fmt::ptr(addr), retCount);
+                return (result_t)std::nullopt;
+            }
+            retCount--;
+        } else if (auto testRes = match(insn, addr)) {
+            if (nToRetOn == 1) return testRes;
+            nToRetOn--;
+        } else if (skip(insn)) {
+            if (nToRetOn == 1) {
+                logger.warn("Found: {} match, at: {} within: {} rets, but the result was a register branch! Cannot compute destination address!", nToRetOn, fmt::ptr(addr), retCount);
+                return (result_t)std::nullopt;
+            }
+            nToRetOn--;
+        }
+        return std::nullopt;
+    };
+
+    for (std::size_t searchIdx = 0; searchIdx < addrs.size(); searchIdx++) {
+        auto& pair = addrs[searchIdx];
+        if (pair.cacheable) {
+            auto range = decoded(pair.addr, pair.remSearchSize / sizeof(uint32_t));
+            for (std::size_t i = 0; i < range.count; i++) {
+                if (auto res = step(range[i], pair.addr + i)) return *res;
+            }
+            pair.addr += range.count;
+            pair.remSearchSize -= range.count * sizeof(uint32_t);
+        } else {
+            for (; pair.remSearchSize >= sizeof(uint32_t); pair.remSearchSize -= sizeof(uint32_t), pair.addr++) {
+                if (auto res = step(decode::decode(*pair.addr, reinterpret_cast<uint64_t>(pair.addr)), pair.addr)) return *res;
+            }
+        }
+        logger.debug("Could not find: {} call at: {} within: {} rets at idx: {}!", nToRetOn, fmt::ptr(pair.addr), retCount, searchIdx);
+    }
+    return (result_t)std::nullopt;
+}
+
+template<decode::Kind... kinds>
+constexpr bool kindMatch(decode::Insn const& insn) {
+    return ((insn.kind == kinds) || ...);
+}
+
+/// @brief Matches a decoded instruction of one of the given kinds, returning its target.
+template<decode::Kind... kinds>
+std::optional<uint32_t*> targetConv(decode::Insn const& insn, uint32_t const*) {
+    if (kindMatch<kinds...>(insn)) return reinterpret_cast<uint32_t*>(insn.imm);
+    return std::nullopt;
+}
+
 std::optional<uint32_t*> blConv(cs_insn* insn);
 
 template<uint32_t nToRetOn, bool includeR = false, int retCount = -1, size_t szBytes = 4096>
@@ -227,48 +417,52 @@ auto findNthBl(const uint32_t* addr) {
     return find_through_hooks(addr, szBytes, [](auto... pairs) {
         std::array addrs{pairs...};
         if constexpr (includeR) {
-            return findNth(addrs, nToRetOn, retCount, &blConv, &insnMatch<ARM64_INS_BLR>);
+            return findNthDecoded(addrs, nToRetOn, retCount, &targetConv<decode::Kind::Bl>, &kindMatch<decode::Kind::Blr>);
         } else {
-            return findNth(addrs, nToRetOn, retCount, &blConv, &insnMatch<>);
+            return findNthDecoded(addrs, nToRetOn, retCount, &targetConv<decode::Kind::Bl>, &kindMatch<>);
         }
     });
 }
 
 std::optional<uint32_t*> bConv(cs_insn* insn);
 
+/// @brief Finds the nToRetOn-th B, counting B.cond as capstone does.
 template<uint32_t nToRetOn, bool includeR = false, int retCount = -1, size_t szBytes = 4096>
 requires ((nToRetOn >= 1 && (szBytes % 4) == 0))
 auto findNthB(const uint32_t* addr) {
     return find_through_hooks(addr, szBytes, [](auto... pairs) {
         std::array addrs{pairs...};
         if constexpr (includeR) {
-            return findNth(addrs, nToRetOn, retCount, &bConv, &insnMatch<ARM64_INS_BR>);
+            return findNthDecoded(addrs, nToRetOn, retCount, &targetConv<decode::Kind::B, decode::Kind::BCond>, &kindMatch<decode::Kind::Br>);
         } else {
-            return findNth(addrs, nToRetOn, retCount, &bConv, &insnMatch<>);
+            return findNthDecoded(addrs, nToRetOn, retCount, &targetConv<decode::Kind::B, decode::Kind::BCond>, &kindMatch<>);
         }
     });
 }
 
 std::optional<std::tuple<uint32_t*, arm64_reg, uint32_t*>> pcRelConv(cs_insn* insn);
+std::optional<std::tuple<uint32_t*, arm64_reg, uint32_t*>> pcRelConv(decode::Insn const& insn, uint32_t const* addr);
 
 template<uint32_t nToRetOn, int retCount = -1, size_t szBytes = 4096>
 requires ((nToRetOn >= 1 && (szBytes % 4) == 0))
 auto findNthPcRel(const uint32_t* addr) {
     return find_through_hooks(addr, szBytes, [](auto... pairs) {
         std::array addrs{pairs...};
-        return findNth(addrs, nToRetOn, retCount, &pcRelConv, &insnMatch<>);
+        return findNthDecoded(addrs, nToRetOn, retCount, [](decode::Insn const& insn, uint32_t const* addr) { return pcRelConv(insn, addr); }, &kindMatch<>);
     });
 }
 
 std::optional<std::tuple<uint32_t*, arm64_reg, int64_t>> regMatchConv(cs_insn* match, arm64_reg toMatch);
+/// @brief regMatchConv for decoded instructions. Words the decoder cannot classify are disassembled with capstone.
+std::optional<std::tuple<uint32_t*, arm64_reg, int64_t>> regMatchConv(decode::Insn const& match, uint32_t const* addr, arm64_reg toMatch);
 
 template<uint32_t nToRetOn, int retCount = -1, size_t szBytes = 4096>
 requires ((nToRetOn >= 1 && (szBytes % 4) == 0))
 auto findNthReg(const uint32_t* addr, arm64_reg reg) {
-    auto lmd = [reg](cs_insn* in) -> std::optional<std::tuple<uint32_t*, arm64_reg, int64_t>> { return regMatchConv(in, reg); };
+    auto lmd = [reg](decode::Insn const& in, uint32_t const* inAddr) { return regMatchConv(in, inAddr, reg); };
     return find_through_hooks(addr, szBytes, [lmd = std::move(lmd)](auto... pairs) {
         std::array addrs{pairs...};
-        return findNth(addrs, nToRetOn, retCount, lmd, &insnMatch<>);
+        return findNthDecoded(addrs, nToRetOn, retCount, lmd, &kindMatch<>);
     });
 }
 
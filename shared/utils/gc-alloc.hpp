@@ -10,25 +10,79 @@
 
 /// @brief Returns an allocated instance of the provided size that will not be written over by future GC allocations and holds references.
 /// You MUST use the gc_free_specific function defined here to destroy it.
+/// The block starts with a 16 byte header recording its size, and the returned pointer is just past it.
+/// It is therefore NOT the start of its GC block: do not GC_free, GC_base or gc_free_fixed it directly.
 /// This function fallsback to calloc if no GC_Alloc or GC_Free implementations are found via xref/sigscan.
 /// @param sz The size to allocate an instance of.
 /// @return The allocated instance.
 [[nodiscard]] void *gc_alloc_specific(size_t sz);
 
 /// @brief Deletes the provided allocated instance from the gc_alloc_specific function defined here.
-/// Other pointers will cause undefined behavior.
-/// This function will call GC_free if there is both a GC_Alloc and GC_Free implementation available, free otherwise.
+/// Other pointers are recognized by their missing header on a best effort basis, and freed the way they would be allocated now.
+/// This function will call GC_free if the instance was allocated from the GC, free if it fell back to calloc.
 /// @param sz The pointer to free explicitly.
 /// @return The allocated instance.
 void gc_free_specific(void *ptr) noexcept;
 
-/// @brief Reallocation implementation is equivalent to: alloc + free
+/// @brief Resizes an allocation from gc_alloc_specific, in place if its block is large enough:
+/// always when shrinking, and when growing within the 16 byte rounding of the block.
+/// Otherwise allocates a new instance with half the new size again to grow into, copies the old size into it and frees the old one,
+/// so that repeated small growth mostly stays in place (growing by doubling still moves every time).
+/// Bytes past the old size are zeroed, as with gc_alloc_specific. A null ptr is equivalent to gc_alloc_specific.
+/// Pointers not from gc_alloc_specific have no recorded size, so new_size bytes are copied out of them and they are freed like gc_free_specific does.
 /// @param ptr The pointer to resize.
 /// @param new_size The new size of the memory.
-/// @return The resized instance.
+/// @return The resized instance, which may be ptr.
 [[nodiscard]] void *gc_realloc_specific(void *ptr, size_t new_size);
 
-/// @brief A C++ allocator that forwards to the il2cpp GC heap.
+/// @brief Returns the size an allocation from gc_alloc_specific was requested with (or last resized to), 0 for nullptr.
+size_t gc_size_specific(void *ptr) noexcept;
+
+/// @brief The largest allocation served from the slab allocator, larger allocations forward to gc_alloc_specific.
+constexpr size_t GC_SLAB_MAX_SIZE = 256;
+
+/// @brief Returns a zeroed allocation of the provided size that holds references, like gc_alloc_specific.
+/// Small sizes are carved out of larger gc_alloc_specific chunks by size class, with a freelist per size class and a cache per thread,
+/// so most allocations and frees do not reach the GC.
+/// Before the GC functions are found, slots come from separate calloc chunks which are never handed out once they are found,
+/// so an allocation made after that is always scanned by the GC.
+/// You MUST use gc_slab_free with the same size to destroy it.
+/// @param sz The size to allocate an instance of.
+/// @return The allocated instance.
+[[nodiscard]] void *gc_slab_alloc(size_t sz);
+
+/// @brief Frees an allocation from gc_slab_alloc. The memory is cleared so it no longer keeps anything alive.
+/// Slab chunks are never returned to the GC, their slots are reused instead.
+/// @param ptr The pointer to free.
+/// @param sz The size it was allocated with.
+void gc_slab_free(void *ptr, size_t sz) noexcept;
+
+/// @brief Resizes an allocation from gc_slab_alloc, in place if both sizes share a size class.
+/// Otherwise allocates a new instance, copies the smaller of the old and new sizes into it and frees the old one.
+/// @param ptr The pointer to resize.
+/// @param old_size The size it was allocated with.
+/// @param new_size The new size of the memory.
+/// @return The resized instance, which may be ptr.
+[[nodiscard]] void *gc_slab_realloc(void *ptr, size_t old_size, size_t new_size);
+
+/// @brief Counters for the slab allocator, across all threads.
+struct gc_slab_stats {
+    /// @brief Allocations served from a slab.
+    size_t allocations;
+    /// @brief Frees returned to a slab.
+    size_t frees;
+    /// @brief Allocations served from the calling thread's cache, without taking a lock.
+    size_t thread_cache_hits;
+    /// @brief Chunks requested from gc_alloc_specific.
+    size_t chunks;
+    /// @brief Allocations larger than GC_SLAB_MAX_SIZE, forwarded to gc_alloc_specific.
+    size_t large_allocations;
+};
+
+/// @brief Returns the current slab allocator counters.
+gc_slab_stats gc_slab_get_stats() noexcept;
+
+/// @brief A C++ allocator that forwards to the il2cpp GC heap, through the slab allocator for small sizes.
 /// Does NOT call any C# constructors on any types, only allocates space for them.
 /// @tparam T The type to specifically allocate.
 template <class T>
@@ -56,7 +110,7 @@ struct gc_allocator {
         {
             throw std::bad_array_new_length();
         }
-        void *const pv = gc_alloc_specific(n * sizeof(T));
+        void *const pv = gc_slab_alloc(n * sizeof(T));
         if (!pv)
         {
             throw std::bad_alloc();
@@ -64,7 +118,7 @@ struct gc_allocator {
         return static_cast<T *>(pv);
     }
 
-    void deallocate(T *const p, size_t) const noexcept {
-        gc_free_specific(p);
+    void deallocate(T *const p, size_t n) const noexcept {
+        gc_slab_free(p, n * sizeof(T));
     }
 };
\ No newline at end of file
@@ -1,26 +1,138 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
 #include <utility>
 
 // TODO: Make this into a static class
 namespace il2cpp_utils {
+    /// @brief Mixes two 64 bit values into one, as wyhash does: a full 64x64 -> 128 bit multiply folded back into 64 bits.
+    constexpr uint64_t hash_mix(uint64_t a, uint64_t b) noexcept {
+        auto r = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(r >> 64) ^ static_cast<uint64_t>(r);
+    }
+
+    /// @brief Combines a hash into a seed. Unlike XOR, the result depends on order and every input bit affects every output bit,
+    /// so pointers (whose low bits are mostly zero) and symmetric pairs do not collide.
+    constexpr std::size_t hash_combine(std::size_t seed, std::size_t value) noexcept {
+        return hash_mix(seed ^ 0xa0761d6478bd642full, value ^ 0xe7037ed1a0b428dbull);
+    }
+
+    /// @brief A string_view with its hash computed once, for looking up keys containing a hashed_string without rehashing on every probe.
+    struct hashed_string_view {
+        std::string_view str;
+        std::size_t hash;
+
+        hashed_string_view(std::string_view s) noexcept : str(s), hash(std::hash<std::string_view>{}(s)) {}
+    };
+
+    /// @brief A string stored with its hash. Equality compares the hashes before the contents.
+    struct hashed_string {
+        std::string str;
+        std::size_t hash;
+
+        hashed_string(std::string_view s) : str(s), hash(std::hash<std::string_view>{}(s)) {}
+        hashed_string(hashed_string_view s) : str(s.str), hash(s.hash) {}
+
+        bool operator==(hashed_string const& other) const noexcept { return hash == other.hash && str == other.str; }
+        bool operator==(hashed_string_view const& other) const noexcept { return hash == other.hash && str == other.str; }
+    };
+
+    /// @brief Hashes a single value, using the cached hash of hashed strings and combining the members of pairs.
+    template<class T>
+    std::size_t hash_value(T const& v) noexcept {
+        return std::hash<T>{}(v);
+    }
+    inline std::size_t hash_value(hashed_string const& v) noexcept {
+        return v.hash;
+    }
+    inline std::size_t hash_value(hashed_string_view const& v) noexcept {
+        return v.hash;
+    }
+    template<class T1, class T2>
+    std::size_t hash_value(std::pair<T1, T2> const& p) noexcept {
+        return hash_combine(hash_value(p.first), hash_value(p.second));
+    }
+
     // A hash function used to hash a pair of any kind
+    // Transparent, so maps keyed by pairs of hashed_string can be searched with pairs of hashed_string_view
     struct hash_pair {
+        using is_transparent = void;
         template<class T1, class T2>
-        size_t operator()(const std::pair<T1, T2>& p) const {
-            auto hash1 = std::hash<T1>{}(p.first);
-            auto hash2 = std::hash<T2>{}(p.second);
-            return hash1 ^ hash2;
+        size_t operator()(const std::pair<T1, T2>& p) const noexcept {
+            return hash_value(p);
         }
     };
     // A hash function used to hash a pair of an object, pair
     struct hash_pair_3 {
+        using is_transparent = void;
         template<class T1, class T2, class T3>
-        size_t operator()(const std::pair<T1, std::pair<T2, T3>>& p) const {
-            auto hash1 = std::hash<T1>{}(p.first);
-            auto hash2 = hash_pair{}(p.second);
-            return hash1 ^ hash2;
+        size_t operator()(const std::pair<T1, std::pair<T2, T3>>& p) const noexcept {
+            return hash_value(p);
         }
     };
+    // Compares pairs memberwise, allowing pairs of hashed_string_view to be compared against pairs of hashed_string
+    struct equal_pair {
+        using is_transparent = void;
+        template<class T1, class T2, class U1, class U2>
+        bool operator()(const std::pair<T1, T2>& a, const std::pair<U1, U2>& b) const noexcept {
+            if constexpr (std::is_same_v<std::pair<T1, T2>, std::pair<U1, U2>>) {
+                return a == b;
+            } else {
+                return equal_member(a.first, b.first) && equal_member(a.second, b.second);
+            }
+        }
+
+       private:
+        template<class T, class U>
+        static bool equal_member(T const& a, U const& b) noexcept {
+            if constexpr (std::is_same_v<T, hashed_string_view>) {
+                return b == a;
+            } else if constexpr (requires { a.first; }) {
+                return equal_pair{}(a, b);
+            } else {
+                return a == b;
+            }
+        }
+    };
+
+    /// @brief Distribution statistics of an unordered container, see get_hash_stats.
+    struct hash_table_stats {
+        std::size_t size;
+        std::size_t bucket_count;
+        /// @brief Buckets holding at least one element
+        std::size_t used_buckets;
+        /// @brief Elements in the fullest bucket
+        std::size_t max_bucket_size;
+        /// @brief Average number of elements compared to find an element that is present
+        double average_probe_length;
+        /// @brief Elements whose full hash equals the hash of another element
+        std::size_t hash_collisions;
+    };
+
+    /// @brief Collects bucket and collision statistics for an unordered container. The caller must hold any lock guarding it.
+    template<class Map>
+    hash_table_stats get_hash_stats(Map const& map) {
+        hash_table_stats stats{ .size = map.size(), .bucket_count = map.bucket_count() };
+        std::size_t probes = 0;
+        for (std::size_t i = 0; i < map.bucket_count(); i++) {
+            auto n = map.bucket_size(i);
+            if (!n) continue;
+            stats.used_buckets++;
+            stats.max_bucket_size = std::max(stats.max_bucket_size, n);
+            // Finding the k-th element of a bucket compares k elements
+            probes += n * (n + 1) / 2;
+        }
+        stats.average_probe_length = map.empty() ? 0 : static_cast<double>(probes) / map.size();
+        std::unordered_set<std::size_t> hashes;
+        auto hasher = map.hash_function();
+        for (auto const& entry : map) {
+            if (!hashes.insert(hasher(entry.first)).second) stats.hash_collisions++;
+        }
+        return stats;
+    }
 }
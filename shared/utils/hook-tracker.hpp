@@ -30,6 +30,11 @@ struct HookTracker {
     static void AddHook(TArgs&&... args) noexcept {
         AddHook(HookInfo(std::forward<TArgs>(args)...));
     }
+    /// @brief Notifies that the code at location was patched, dropping anything cached from the original code.
+    /// AddHook does this itself, this only needs to be called for untracked patches.
+    /// @param location The start of the patched code.
+    /// @param size The size of the patch, in bytes.
+    static void CodePatched(const void* const location, std::size_t size) noexcept;
     /// @brief Stops tracking the provided HookInfo.
     /// @param info The HookInfo to stop tracking.
     static void RemoveHook(HookInfo info) noexcept;
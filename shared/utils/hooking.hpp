@@ -103,6 +103,22 @@ struct HookCatchWrapper<Func, R (*)(TArgs...)> {
     }
 };
 
+template<auto Func, class T, bool translate = true>
+/// @brief Exposes a static wrapper method that forwards to the provided function pointer, guarded by a single catch-all landing pad.
+/// Unlike HookCatchWrapper, the catch clauses are not inlined into the wrapper; the in-flight exception is instead classified out of line
+/// by il2cpp_utils::HandleUncaughtException, so the non-throwing path only pays for the unwind table entry.
+/// If translate is false, exceptions are never raised into the il2cpp domain, they are logged and the process aborts.
+struct HookLandingPadWrapper;
+
+template<auto Func, bool translate, class R, class... TArgs>
+struct HookLandingPadWrapper<Func, R (*)(TArgs...), translate> {
+    static R wrapper(TArgs... args) {
+        IL2CPP_LANDING_PAD_HANDLER(translate,
+            return Func(args...);
+        )
+    }
+};
+
 // TODO: Make a pending_install collection and add HookInfo to it to ensure installation
 // Then, walk this at load time and install (could do so after il2cpp_functions::Init)
 
@@ -132,6 +148,34 @@ struct Hook_##name_ { \
 }; \
 retval Hook_##name_::hook_##name_(__VA_ARGS__)
 
+// Make an address-specified hook, that has a single catch-all landing pad instead of a full catch handler.
+// Prefer this over MAKE_HOOK for hooks on methods that are called very frequently (ex: per frame).
+#define MAKE_HOOK_LANDING_PAD(name_, addr_, retval, ...) \
+struct Hook_##name_ { \
+    constexpr static const char* name() { return #name_; } \
+    constexpr static void* addr() { return (void*) addr_; } \
+    using funcType = retval (*)(__VA_ARGS__); \
+    static funcType* trampoline() { return &name_; } \
+    static inline retval (*name_)(__VA_ARGS__) = nullptr; \
+    static funcType hook() { return &::Hooking::HookLandingPadWrapper<&hook_##name_, funcType>::wrapper; } \
+    static retval hook_##name_(__VA_ARGS__); \
+}; \
+retval Hook_##name_::hook_##name_(__VA_ARGS__)
+
+// Make an address-specified hook, that has a single catch-all landing pad which never translates exceptions to il2cpp exceptions.
+// Any exception escaping the hook is logged and aborts.
+#define MAKE_HOOK_LANDING_PAD_NO_TRANSLATE(name_, addr_, retval, ...) \
+struct Hook_##name_ { \
+    constexpr static const char* name() { return #name_; } \
+    constexpr static void* addr() { return (void*) addr_; } \
+    using funcType = retval (*)(__VA_ARGS__); \
+    static funcType* trampoline() { return &name_; } \
+    static inline retval (*name_)(__VA_ARGS__) = nullptr; \
+    static funcType hook() { return &::Hooking::HookLandingPadWrapper<&hook_##name_, funcType, false>::wrapper; } \
+    static retval hook_##name_(__VA_ARGS__); \
+}; \
+retval Hook_##name_::hook_##name_(__VA_ARGS__)
+
 // Make a hook that resolves the 'infoGet' expression an installs the hook to that MethodInfo*, that has a catch handler.
 #define MAKE_HOOK_FIND_VERBOSE(name_, infoGet, retval, ...) \
 struct Hook_##name_ { \
@@ -462,6 +506,7 @@ struct Hook_##name_ { \
     static_assert(std::is_same_v<funcType, ::Hooking::InternalMethodCheck<decltype(mPtr)>::funcType>, "Hook method signature does not match!"); \
     constexpr static const char* name() { return #name_; } \
     static const MethodInfo* getInfo() { return ::il2cpp_utils::il2cpp_type_check::MetadataGetter<mPtr>::methodInfo(); } \
+    static inline ::il2cpp_utils::WarmUpRegistration warmUp{ "Hook_" #name_, &getInfo }; \
     static funcType* trampoline() { return &name_; } \
     static inline retval (*name_)(__VA_ARGS__) = nullptr; \
     static funcType hook() { return &::Hooking::HookCatchWrapper<&hook_##name_, funcType>::wrapper; } \
@@ -478,6 +523,7 @@ struct Hook_##name_ { \
     static_assert(std::is_same_v<funcType, ::Hooking::InternalMethodCheck<decltype(mPtr)>::funcType>, "Hook method signature does not match!"); \
     constexpr static const char* name() { return #name_; } \
     static const MethodInfo* getInfo() { return ::il2cpp_utils::il2cpp_type_check::MetadataGetter<mPtr>::methodInfo(); } \
+    static inline ::il2cpp_utils::WarmUpRegistration warmUp{ "Hook_" #name_, &getInfo }; \
     static funcType* trampoline() { return &name_; } \
     static inline retval (*name_)(__VA_ARGS__) = nullptr; \
     static funcType hook() { return hook_##name_; } \
@@ -485,6 +531,40 @@ struct Hook_##name_ { \
 }; \
 retval Hook_##name_::hook_##name_(__VA_ARGS__)
 
+// Make a hook that uses the provided method pointer in a match an ensures the signature matches.
+// Has a single catch-all landing pad instead of a full catch handler, see MAKE_HOOK_LANDING_PAD.
+#define MAKE_HOOK_MATCH_LANDING_PAD(name_, mPtr, retval, ...) \
+struct Hook_##name_ { \
+    using funcType = retval (*)(__VA_ARGS__); \
+    static_assert(MATCH_HOOKABLE_ASSERT(mPtr)); \
+    static_assert(std::is_same_v<funcType, ::Hooking::InternalMethodCheck<decltype(mPtr)>::funcType>, "Hook method signature does not match!"); \
+    constexpr static const char* name() { return #name_; } \
+    static const MethodInfo* getInfo() { return ::il2cpp_utils::il2cpp_type_check::MetadataGetter<mPtr>::methodInfo(); } \
+    static inline ::il2cpp_utils::WarmUpRegistration warmUp{ "Hook_" #name_, &getInfo }; \
+    static funcType* trampoline() { return &name_; } \
+    static inline retval (*name_)(__VA_ARGS__) = nullptr; \
+    static funcType hook() { return &::Hooking::HookLandingPadWrapper<&hook_##name_, funcType>::wrapper; } \
+    static retval hook_##name_(__VA_ARGS__); \
+}; \
+retval Hook_##name_::hook_##name_(__VA_ARGS__)
+
+// Make a hook that uses the provided method pointer in a match an ensures the signature matches.
+// Has a single catch-all landing pad which never translates exceptions to il2cpp exceptions, see MAKE_HOOK_LANDING_PAD_NO_TRANSLATE.
+#define MAKE_HOOK_MATCH_LANDING_PAD_NO_TRANSLATE(name_, mPtr, retval, ...) \
+struct Hook_##name_ { \
+    using funcType = retval (*)(__VA_ARGS__); \
+    static_assert(MATCH_HOOKABLE_ASSERT(mPtr)); \
+    static_assert(std::is_same_v<funcType, ::Hooking::InternalMethodCheck<decltype(mPtr)>::funcType>, "Hook method signature does not match!"); \
+    constexpr static const char* name() { return #name_; } \
+    static const MethodInfo* getInfo() { return ::il2cpp_utils::il2cpp_type_check::MetadataGetter<mPtr>::methodInfo(); } \
+    static inline ::il2cpp_utils::WarmUpRegistration warmUp{ "Hook_" #name_, &getInfo }; \
+    static funcType* trampoline() { return &name_; } \
+    static inline retval (*name_)(__VA_ARGS__) = nullptr; \
+    static funcType hook() { return &::Hooking::HookLandingPadWrapper<&hook_##name_, funcType, false>::wrapper; } \
+    static retval hook_##name_(__VA_ARGS__); \
+}; \
+retval Hook_##name_::hook_##name_(__VA_ARGS__)
+
 // TODO: Remove all of these macros and replace it with just one or MAYBE two-- if people want to do it themselves
 // they can implement the structure themselves
 
@@ -551,6 +631,7 @@ struct Hook_##name_ { \
     /* static_assert(std::is_same_v<funcType, ::Hooking::InternalMethodCheck<decltype(mPtr)>::funcType>, "Hook method signature does not match!"); */ \
     constexpr static const char* name() { return #name_; } \
     static const MethodInfo* getInfo() { return ::il2cpp_utils::il2cpp_type_check::MetadataGetter<mPtr>::methodInfo(); } \
+    static inline ::il2cpp_utils::WarmUpRegistration warmUp{ "Hook_" #name_, &getInfo }; \
     static funcType* trampoline() { return &orig_base; } \
     static inline funcType orig_base = nullptr; \
     template<class... TArgs> \
@@ -618,6 +699,7 @@ inline void __InstallHook(L& logger, void* addr) {
         HookTracker::AddHook(info);
     } else {
         A64HookFunction(addr, (void*) T::hook(), (void**) T::trampoline());
+        HookTracker::CodePatched(addr, sizeof(HookInfo::original_data));
     }
     #else
     registerInlineHook((uint32_t) addr, (uint32_t) T::hook(), (uint32_t **) T::trampoline());
@@ -28,12 +28,15 @@ constexpr bool has_get = std::experimental::is_detected_v<get_t, T>;
 #endif
 
 #include "utils.h"
+#include <atomic>
+#include <cstddef>
 #include <string_view>
 
 #ifndef classof
 // Returns the Il2CppClass* of the provided type T.
 // Should be a pointer type if it is a reference type, otherwise it should be a value type.
-#define classof(...) (::il2cpp_utils::il2cpp_type_check::il2cpp_no_arg_class<__VA_ARGS__>::get())
+// Once il2cpp_functions::Init has resolved the classof table, this is a single load.
+#define classof(...) (::il2cpp_utils::il2cpp_type_check::classof_slot<__VA_ARGS__>::get())
 #endif
 
 #ifndef csTypeOf
@@ -93,9 +96,19 @@ namespace il2cpp_utils {
 
     // Function made by zoller27osu, modified by Sc2ad
     // PLEASE don't use, there are easier ways to get generics (see CreateParam, CreateFieldValue)
+    // Results are cached. Instantiations il2cpp was compiled with are found natively, others go through Type.MakeGenericType.
     Il2CppClass* MakeGeneric(const Il2CppClass* klass, std::span<const Il2CppClass* const> args);
     Il2CppClass* MakeGeneric(const Il2CppClass* klass, const Il2CppType** types, uint32_t numTypes);
 
+    /// @brief Adds a classof slot to the table resolved by ResolveClassofSlots. Safe to call during static initialization.
+    /// @param slot Where the class is stored, read by classof
+    /// @param resolve Looks the class up and stores it into slot
+    void RegisterClassofSlot(std::atomic<Il2CppClass*>* slot, Il2CppClass* (*resolve)());
+    /// @brief Resolves every classof slot which is still empty, so that later classof calls never look anything up.
+    /// il2cpp_functions::Init calls this once il2cpp has loaded its metadata. Call it again after loading more classof users (ex: dlopen).
+    /// @return The number of slots which could not be resolved
+    std::size_t ResolveClassofSlots();
+
     // Framework provided by DaNike
     namespace il2cpp_type_check {
     namespace {
@@ -255,6 +268,10 @@ namespace il2cpp_utils {
 
         template <typename T>
         struct BS_HOOKS_HIDDEN il2cpp_arg_class {
+            // The class is derived from T alone, never from the value, so it may be cached per T.
+            // Specializations that inspect the value must not define this.
+            static constexpr bool instance_independent = true;
+
             static inline Il2CppClass* get([[maybe_unused]] T arg) {
                 if constexpr (has_get<il2cpp_no_arg_class<T>>) {
                     return il2cpp_no_arg_class<T>::get();
@@ -263,6 +280,40 @@ namespace il2cpp_utils {
             }
         };
 
+        /// @brief The table slot classof reads the Il2CppClass* of T from.
+        /// Each slot registers itself at static initialization and is filled by ResolveClassofSlots,
+        /// or by the first classof call if that has not happened yet.
+        template <typename T>
+        struct BS_HOOKS_HIDDEN classof_slot {
+            // Constant initialized, so reading it needs no guard
+            static constinit inline std::atomic<Il2CppClass*> klass{ nullptr };
+
+            static Il2CppClass* resolve() {
+                auto* ret = il2cpp_no_arg_class<T>::get();
+                // The class is fully set up by il2cpp before a lookup can return it
+                klass.store(ret, std::memory_order_relaxed);
+                return ret;
+            }
+
+            static inline Il2CppClass* get() {
+                // Instantiates the registration of this slot
+                (void)&registration;
+                // A plain load; the slot is only empty before Init, or for a library loaded after it until ResolveClassofSlots runs again
+                if (auto* ret = klass.load(std::memory_order_relaxed)) [[likely]] {
+                    return ret;
+                }
+                return resolve();
+            }
+
+           private:
+            struct registrar {
+                registrar() {
+                    RegisterClassofSlot(&klass, &resolve);
+                }
+            };
+            static inline registrar registration;
+        };
+
 #define DEFINE_IL2CPP_DEFAULT_TYPE(type, fieldName) \
         template<> \
         struct BS_HOOKS_HIDDEN ::il2cpp_utils::il2cpp_type_check::il2cpp_no_arg_class<type> { \
@@ -308,6 +359,12 @@ namespace il2cpp_utils {
 
         NEED_NO_BOX(Il2CppClass);
 
+        /// @brief Whether the Il2CppType* of an argument of type T is always the same, regardless of its value.
+        template <typename T>
+        concept il2cpp_arg_instance_independent = requires {
+            requires il2cpp_arg_class<std::decay_t<T>>::instance_independent;
+        };
+
         template <>
         struct BS_HOOKS_HIDDEN il2cpp_arg_class<Il2CppClass*> {
             static inline Il2CppClass* get(Il2CppClass* arg) {
@@ -62,12 +62,17 @@ namespace il2cpp_utils {
     }
 
     std::string GenericClassStandardName(Il2CppGenericClass* genClass);
+
+    // Returns the instantiations of the given generic definition (ex: List`1) which il2cpp was compiled with
+    // The map behind it is built from the metadata registration on first use and only extended afterwards
+    ::std::vector<Il2CppGenericClass*> GetGenericInstantiations(const Il2CppClass* klass);
     // Some parts provided by zoller27osu
     // Logs information about the given Il2CppClass* as log(DEBUG)
     void LogClass(Paper::LoggerContext const& logger, Il2CppClass* klass, bool logParents = false) noexcept;
 
     // Logs all classes (from every namespace) that start with the given prefix
     // WARNING: THIS FUNCTION IS VERY SLOW. ONLY USE THIS FUNCTION ONCE AND WITH A FAIRLY SPECIFIC PREFIX!
+    // To dump many classes, use DumpClasses instead, which streams them to a file
     void LogClasses(Paper::LoggerContext const& logger, ::std::string_view classPrefix, bool logParents = false) noexcept;
 
     // Gets the System.Type Il2CppObject* (actually an Il2CppReflectionType*) for an Il2CppClass*
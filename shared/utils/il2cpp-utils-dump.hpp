@@ -0,0 +1,46 @@
+#pragma once
+
+#include "inline-function.hpp"
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct Il2CppClass;
+
+namespace il2cpp_utils {
+    /// @brief Which classes DumpClasses writes, and how.
+    struct ClassDumpOptions {
+        /// @brief Only classes whose name starts with this prefix, as with LogClasses
+        std::string classPrefix;
+        /// @brief Only classes whose namespace starts with this prefix
+        std::string namespacePrefix;
+        /// @brief Only classes of these assemblies (ex: "Main"), or of every assembly if empty
+        std::vector<std::string> assemblies;
+        /// @brief Additional filter, called from the dumping threads
+        InlineFunction<bool(Il2CppClass*)> filter;
+        bool methods = true;
+        bool fields = true;
+        bool properties = true;
+        /// @brief Number of threads assemblies are dumped on, or 0 to pick one from the number of cores
+        std::size_t threads = 0;
+        /// @brief Bytes each thread buffers before writing them to the file
+        std::size_t bufferSize = 64 * 1024;
+    };
+
+    struct ClassDumpStats {
+        std::size_t assemblies = 0;
+        std::size_t classes = 0;
+        std::size_t bytes = 0;
+        std::chrono::milliseconds elapsed{};
+    };
+
+    /// @brief Writes the classes matching options to path as JSON lines: one object per class, holding its
+    /// assembly, name, parent, flags and (depending on options) its fields, properties and methods.
+    /// Unlike LogClasses, classes are written as they are visited, never recursed into or collected, so memory use is bounded by the buffers.
+    /// Assemblies are dumped in parallel, on threads attached to il2cpp. Safe to call from several threads at once.
+    /// @return The dump statistics, or nullopt if the file could not be written
+    std::optional<ClassDumpStats> DumpClasses(std::string_view path, ClassDumpOptions const& options = {});
+}
@@ -6,6 +6,7 @@
 #include <string>
 #include <stdexcept>
 #include <typeinfo>
+#include <memory>
 #include "utils-functions.h"
 
 #include "paper2_scotland2/shared/backtrace.hpp"
@@ -21,23 +22,39 @@ namespace il2cpp_utils {
     std::string ClassStandardName(const Il2CppClass* klass, bool generics);
 
     namespace exceptions {
+        /// @brief The maximum number of frames that will ever be captured for an exception backtrace.
+        constexpr static uint16_t MAX_STACK_TRACE_SIZE = 256;
+
+        /// @brief Configures backtrace capture for StackTraceException and RunMethodException. Thread safe.
+        /// @param depth The maximum number of frames to capture, clamped to MAX_STACK_TRACE_SIZE. 0 disables capture entirely.
+        /// @param sampleRate Only one in every sampleRate exceptions will capture a backtrace. 0 or 1 captures a backtrace for every exception.
+        void SetBacktraceCapture(uint16_t depth, uint32_t sampleRate = 1) noexcept;
+        /// @brief Returns the current maximum number of frames captured per exception, 0 if capture is disabled.
+        uint16_t GetBacktraceCaptureDepth() noexcept;
+        /// @brief Returns the current backtrace sample rate.
+        uint32_t GetBacktraceSampleRate() noexcept;
+
+        /// @brief A backtrace captured at the time an exception was constructed.
+        /// Frames are stored compactly on the heap and shared between copies of the exception.
+        /// Nothing is allocated if capture is disabled, or this exception was not sampled.
+        /// Symbolization only happens when the backtrace is logged.
+        struct CapturedBacktrace {
+            std::shared_ptr<void* const[]> frames;
+            uint16_t size = 0;
+
+            /// @brief Captures a backtrace of the calling thread, respecting the configuration provided to SetBacktraceCapture.
+            static CapturedBacktrace capture(uint16_t skip = 0) noexcept;
+            // Logs the backtrace with the Logging::ERROR level, using the global logger instance.
+            void log(std::string_view header) const;
+        };
+
         // TODO: Move all custom exceptions to this namespace?
         struct StackTraceException : std::runtime_error {
-            constexpr static uint16_t STACK_TRACE_SIZE = 256;
+            CapturedBacktrace stacktrace;
 
-            void* stacktrace_buffer[STACK_TRACE_SIZE];
-            uint16_t stacktrace_size;
-
-            StackTraceException(std::string_view msg) : std::runtime_error(msg.data()) {
-                // TODO: Eventually skip two frames (assuming no inlined methods) for this constructor and the captured backtrace call.
-                stacktrace_size = backtrace_helpers::captureBacktrace(stacktrace_buffer, STACK_TRACE_SIZE, 0);
-            }
+            StackTraceException(std::string_view msg) : std::runtime_error(msg.data()), stacktrace(CapturedBacktrace::capture()) {}
+            // Logs the backtrace with the Logging::ERROR level, using the global logger instance.
             void log_backtrace() const;
-
-            [[nodiscard]] virtual char const* what() const noexcept override {
-                log_backtrace();
-                return std::runtime_error::what();
-            }
         };
 
         struct NullException : public il2cpp_utils::exceptions::StackTraceException {
@@ -69,6 +86,12 @@ namespace il2cpp_utils {
     #endif
 
     #if __has_feature(cxx_exceptions)
+    /// @brief Handles the exception currently being caught, identically to IL2CPP_CATCH_HANDLER, but out of line.
+    /// MUST be called from within a catch block.
+    /// @param modId The ID of the mod the exception was caught in, for logging.
+    /// @param translate Whether the exception should be raised into the il2cpp domain. If false, always logs and aborts.
+    [[noreturn, gnu::cold, gnu::noinline]] void HandleUncaughtException(char const* modId, bool translate);
+
     struct Il2CppUtilsException : exceptions::StackTraceException {
         std::string context;
         std::string msg;
@@ -87,21 +110,12 @@ namespace il2cpp_utils {
         }
     };
     struct RunMethodException : std::runtime_error {
-        constexpr static uint16_t STACK_TRACE_SIZE = 256;
-
         const Il2CppException* ex;
         const MethodInfo* info;
-        void* stacktrace_buffer[STACK_TRACE_SIZE];
-        uint16_t stacktrace_size;
+        exceptions::CapturedBacktrace stacktrace;
 
-        RunMethodException(std::string_view msg, const MethodInfo* inf) __attribute__((noinline)) : std::runtime_error(msg.data()), ex(nullptr), info(inf) {
-            // TODO: Eventually skip two frames (assuming no inlined methods) for this constructor and the captured backtrace call.
-            stacktrace_size = backtrace_helpers::captureBacktrace(stacktrace_buffer, STACK_TRACE_SIZE, 0);
-        }
-        RunMethodException(Il2CppException* exp, const MethodInfo* inf) __attribute__((noinline)) : std::runtime_error(ExceptionToString(exp).c_str()), ex(exp), info(inf) {
-            // TODO: Eventually skip two frames (assuming no inlined methods) for this constructor and the captured backtrace call.
-            stacktrace_size = backtrace_helpers::captureBacktrace(stacktrace_buffer, STACK_TRACE_SIZE, 0);
-        }
+        RunMethodException(std::string_view msg, const MethodInfo* inf) __attribute__((noinline)) : std::runtime_error(msg.data()), ex(nullptr), info(inf), stacktrace(exceptions::CapturedBacktrace::capture()) {}
+        RunMethodException(Il2CppException* exp, const MethodInfo* inf) __attribute__((noinline)) : std::runtime_error(ExceptionToString(exp).c_str()), ex(exp), info(inf), stacktrace(exceptions::CapturedBacktrace::capture()) {}
         // TODO: Add a logger argument here so we could better write out to a targetted buffer.
         // For now, we will stick to using the UtilsLogger.
         // It will be our caller's responsibility to determine what to do AFTER the backtrace is logged-- whether it be to terminate or rethrow.
@@ -115,11 +129,6 @@ namespace il2cpp_utils {
             throw Il2CppExceptionWrapper(ex);
             #endif
         }
-
-        [[nodiscard]] virtual char const* what() const noexcept override {
-            log_backtrace();
-            return std::runtime_error::what();
-        }
     };
     #endif
 }
@@ -166,4 +175,14 @@ namespace il2cpp_utils {
     SAFE_ABORT(); \
 }
 
+// Implements a single catch-all landing pad around the provided body.
+// Any exception that escapes the body is handled out of line by il2cpp_utils::HandleUncaughtException, in the same way as IL2CPP_CATCH_HANDLER.
+// Since the handler is not inlined, the only cost of the barrier on the non-throwing path is the unwind table entry for the landing pad.
+// If translate is false, no exceptions will be raised into the il2cpp domain, they are logged and the process aborts instead.
+#define IL2CPP_LANDING_PAD_HANDLER(translate, ...) try { \
+    __VA_ARGS__ \
+} catch (...) { \
+    ::il2cpp_utils::HandleUncaughtException(_CATCH_HANDLER_ID, translate); \
+}
+
 #endif
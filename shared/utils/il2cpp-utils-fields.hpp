@@ -28,6 +28,8 @@ namespace il2cpp_utils {
     // Returns the FieldInfo for the field of the given class with the given name
     // Created by zoller27osu
     FieldInfo* FindField(Il2CppClass* klass, ::std::string_view fieldName);
+    // As FindField, but without logging or dumping the class when the field is not found. Misses are cached, see SetLookupMissExpiry
+    FieldInfo* TryFindField(Il2CppClass* klass, ::std::string_view fieldName);
     // Wrapper for FindField taking a namespace and class name in place of an Il2CppClass*
     template<class... TArgs>
     FieldInfo* FindField(::std::string_view nameSpace, ::std::string_view className, TArgs&&... params) {
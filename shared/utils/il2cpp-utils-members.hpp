@@ -0,0 +1,59 @@
+#pragma once
+
+#pragma pack(push)
+
+#include "il2cpp-functions.hpp"
+#include "hashing.hpp"
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace il2cpp_utils {
+    /// @brief The members of a class by name, including those inherited from its parents and the methods of the interfaces it implements.
+    /// Names point into il2cpp metadata, so lookups neither allocate nor compare more than the members with the requested name.
+    struct ClassMemberIndex {
+        /// @brief Methods by name, in resolution order: those of the class itself first, then those of each parent.
+        std::unordered_map<std::string_view, std::vector<const MethodInfo*>> methods;
+        /// @brief Implementations of the interface methods of the class, by the interface method's name, which are not already in methods.
+        /// Only resolved, callable implementations are kept (ex: explicit implementations such as System.IDisposable.Dispose under Dispose).
+        /// Lookups only fall back to these when methods has no candidate, so they never change which class or parent method is found.
+        std::unordered_map<std::string_view, std::vector<const MethodInfo*>> interfaceMethods;
+        /// @brief The first field with each name, looking at the class and then each parent.
+        std::unordered_map<std::string_view, FieldInfo*> fields;
+        /// @brief The first property with each name, looking at the class and then each parent.
+        std::unordered_map<std::string_view, const PropertyInfo*> properties;
+
+        std::span<const MethodInfo* const> FindMethods(std::string_view name) const noexcept {
+            auto itr = methods.find(name);
+            if (itr == methods.end()) return {};
+            return itr->second;
+        }
+
+        std::span<const MethodInfo* const> FindInterfaceMethods(std::string_view name) const noexcept {
+            auto itr = interfaceMethods.find(name);
+            if (itr == interfaceMethods.end()) return {};
+            return itr->second;
+        }
+
+        FieldInfo* FindField(std::string_view name) const noexcept {
+            auto itr = fields.find(name);
+            return itr == fields.end() ? nullptr : itr->second;
+        }
+
+        const PropertyInfo* FindProperty(std::string_view name) const noexcept {
+            auto itr = properties.find(name);
+            return itr == properties.end() ? nullptr : itr->second;
+        }
+    };
+
+    /// @brief Returns the member index of klass, building it on first use. The index lives as long as the process.
+    /// Used by FindField, FindProperty, FindMethodUnsafe and FindMethod.
+    /// @param klass The class to index, which is initialized if it has not been yet
+    ClassMemberIndex const& GetMemberIndex(Il2CppClass* klass);
+
+    /// @brief Statistics of the map from classes to their member indices
+    hash_table_stats GetMemberIndexStats();
+}
+
+#pragma pack(pop)
@@ -8,6 +8,8 @@
 #pragma pack(push)
 
 #include <array>
+#include <atomic>
+#include <cstring>
 #include <exception>
 #include <vector>
 #include "il2cpp-functions.hpp"
@@ -50,12 +52,14 @@ void LogMethods(Paper::LoggerContext const& logger, Il2CppClass const* klass, bo
 
 /// @brief Manually creates an instance of the provided Il2CppClass*.
 /// The created instance's type initializer will NOT execute on another thread! Be warned!
+/// It runs once per class, other threads creating an instance at the same time wait for it to finish.
 /// Must be freed using gc_free_specific!
 /// @param klass The Il2CppClass* to create an instance of.
 /// @return The created instance, or nullptr if it failed for any reason.
 Il2CppObject* createManual(const Il2CppClass* klass) noexcept;
 /// @brief Manually creates an instance of the provided Il2CppClass*.
 /// The created instance's type initializer will NOT execute on another thread! Be warned!
+/// It runs once per class, other threads creating an instance at the same time wait for it to finish.
 /// Must be freed using gc_free_specific!
 /// This function will throw a exceptions::StackTraceException on failure.
 /// @param klass The Il2CppClass* to create an instance of.
@@ -183,6 +187,15 @@ inline auto ExtractValues(TArgs&&... args) {
     return std::array<void*, array_count>(::il2cpp_utils::ExtractValue(args)...);
 }
 
+/// @brief As FindMethodUnsafe, but without logging or dumping the class when the method is not found.
+/// Use this to probe for methods which may not exist. Misses are cached, see SetLookupMissExpiry.
+/// @return The found MethodInfo*, or nullptr
+const MethodInfo* TryFindMethodUnsafe(const Il2CppClass* klass, ::std::string_view methodName, int argsCount);
+/// @brief As FindMethod, but without logging or dumping the class when no method matches.
+/// Use this to probe for methods which may not exist. Misses are cached, see SetLookupMissExpiry.
+/// @return The found MethodInfo*, or nullptr
+const MethodInfo* TryFindMethod(FindMethodInfo&& info);
+
 #if __has_feature(cxx_exceptions)
 /// @brief Instantiates a generic MethodInfo* from the provided Il2CppClasses.
 /// This method will throw an Il2CppUtilException if it fails for any reason.
@@ -375,6 +388,94 @@ bool ParameterMatch(const MethodInfo* method, std::array<const Il2CppType*, sz>
     return ParameterMatch<0, sz>(method, std::span<const Il2CppClass* const, 0>(), argTypes, isIdenticalOut);
 }
 
+/// @brief A small direct mapped table of the MethodInfo*s that have passed CheckMethodTypes for one C++ signature.
+template <class TOut, class... TArgs>
+struct VerifiedMethods {
+    static constexpr std::size_t size = 16;
+    static inline std::array<std::atomic<const MethodInfo*>, size> table{};
+
+    static std::atomic<const MethodInfo*>& slot(const MethodInfo* method) noexcept {
+        return table[(reinterpret_cast<uintptr_t>(method) >> 4) % size];
+    }
+};
+
+/// @brief A small direct mapped, per thread table of the MethodInfo*s and argument types that have passed CheckMethodTypes for one C++ signature,
+/// used when the argument types depend on the argument values (ex: T* arguments, whose class is read from the instance).
+template <class TOut, class... TArgs>
+struct VerifiedCalls {
+    using types_t = std::array<const Il2CppType*, sizeof...(TArgs)>;
+    struct entry {
+        const MethodInfo* method;
+        types_t types;
+    };
+    static constexpr std::size_t size = 16;
+    static inline thread_local std::array<entry, size> table{};
+
+    static entry& slot(const MethodInfo* method, types_t const& types) noexcept {
+        auto hash = reinterpret_cast<uintptr_t>(method) >> 4;
+        for (auto* type : types) {
+            hash = hash * 31 + (reinterpret_cast<uintptr_t>(type) >> 4);
+        }
+        return table[hash % size];
+    }
+};
+
+/// @brief Performs the type checks used when checkTypes is true:
+/// the parameters must match the method's parameters, and the method's return type must be convertible to TOut.
+/// Once a method passes, the result is cached for this C++ signature, so repeated checks cost a single pointer compare.
+/// If the types of some arguments depend on their values (ex: a pointer to an instance of a derived class),
+/// the result is instead cached for the extracted argument types, so repeated checks only cost extracting them.
+/// @return The RunMethodException describing the mismatch, or std::nullopt if the types are valid for the method.
+template <class TOut, class... TArgs>
+std::optional<RunMethodException> CheckMethodTypes(const MethodInfo* method, TArgs&&... params) {
+    constexpr bool cacheable = (il2cpp_type_check::il2cpp_arg_instance_independent<TArgs> && ...);
+    using verified_calls = VerifiedCalls<TOut, std::decay_t<TArgs>...>;
+    [[maybe_unused]] typename verified_calls::types_t types;
+    if constexpr (cacheable) {
+        if (VerifiedMethods<TOut, std::decay_t<TArgs>...>::slot(method).load(std::memory_order_relaxed) == method) {
+            return std::nullopt;
+        }
+    } else {
+        types = { ::il2cpp_utils::ExtractType(params)... };
+        auto const& verified = verified_calls::slot(method, types);
+        if (verified.method == method && verified.types == types) {
+            return std::nullopt;
+        }
+    }
+
+    auto const& logger = il2cpp_utils::Logger;
+    // only check args if TArgs is > 0
+    if (method->parameters_count != sizeof...(TArgs)) {
+        logger.warn("MethodInfo parameter count {} does not match actual parameter count {}", method->parameters_count, sizeof...(TArgs));
+    }
+
+    if constexpr (sizeof...(TArgs) > 0) {
+        if constexpr (cacheable) {
+            types = { ::il2cpp_utils::ExtractType(params)... };
+        }
+        if (!ParameterMatch(method, types, std::nullopt)) {
+            return RunMethodException("Parameters do not match!", method);
+        }
+    }
+
+    if constexpr (!std::is_same_v<TOut, void>) {
+        auto* outType = ExtractIndependentType<TOut>();
+        if (outType) {
+            if (!IsConvertibleFrom(outType, method->return_type, false)) {
+                logger.warn("User requested TOut {} does not match the method's return object of type {}!", TypeGetSimpleName(outType), TypeGetSimpleName(method->return_type));
+                return RunMethodException(fmt::format("Return type of method is not convertible to: {}!", TypeGetSimpleName(outType)), method);
+            }
+        }
+    }
+
+    if constexpr (cacheable) {
+        VerifiedMethods<TOut, std::decay_t<TArgs>...>::slot(method).store(method, std::memory_order_relaxed);
+    } else {
+        verified_calls::slot(method, types) = { method, types };
+    }
+    return std::nullopt;
+}
+
 /// @brief Calls the methodPointer on the provided const MethodInfo*, but throws a RunMethodException on failure.
 /// If checkTypes is false, does not perform type checking and instead is a partially unsafe wrapper around invoking the methodPointer directly.
 /// This function still performs simple checks (such as void vs. non-void returns and instance vs. static method invokes) even with checkTypes as false.
@@ -389,7 +490,6 @@ bool ParameterMatch(const MethodInfo* method, std::array<const Il2CppType*, sz>
 /// @param params The arguments to pass into the function.
 template <class TOut = void, bool checkTypes = true, class T, class... TArgs>
 TOut RunMethodFnPtr(T* instance, const MethodInfo* method, Il2CppMethodPointer mPtr, TArgs&&... params) {
-    auto const& logger = il2cpp_utils::Logger;
     if (!method) {
         throw RunMethodException("Method cannot be null!", nullptr);
     }
@@ -398,16 +498,8 @@ TOut RunMethodFnPtr(T* instance, const MethodInfo* method, Il2CppMethodPointer m
     }
 
     if constexpr (checkTypes && sizeof...(TArgs) > 0) {
-        std::array<const Il2CppType*, sizeof...(TArgs)> types{ ::il2cpp_utils::ExtractType(params)... };
-        if (!ParameterMatch(method, types, std::nullopt)) {
-            throw RunMethodException("Parameters do not match!", method);
-        }
-        auto* outType = ExtractIndependentType<TOut>();
-        if (outType) {
-            if (!IsConvertibleFrom(outType, method->return_type, false)) {
-                logger.warn("User requested TOut {} does not match the method's return object of type {}!", TypeGetSimpleName(outType), TypeGetSimpleName(method->return_type));
-                throw RunMethodException("Return type of method is not convertible!", method);
-            }
+        if (auto exc = CheckMethodTypes<TOut>(method, params...)) {
+            throw *exc;
         }
     }
     // NOTE: We need to remove references from our method pointers and copy in our parameters
@@ -555,78 +647,112 @@ using MethodResult = ::il2cpp_utils::Result<TOut, RunMethodException>;
 namespace invokers {
 // TODO: invoker concept
 
-// TODO: Fix
-template <typename TOut, typename T, typename... TArgs>
-MethodResult<TOut> FnPtrInvoker(T* instance, const MethodInfo* method, TArgs&&... params) noexcept {
-    bool isStatic = method->flags & METHOD_ATTRIBUTE_STATIC;
-    if (isStatic && method->klass && !method->klass->cctor_finished_or_no_cctor) {
-        il2cpp_functions::Class_Init(method->klass);
+/// @brief The type a C++ argument or return value is passed as when calling a methodPointer directly.
+/// Wrapper types (and ByRef) are passed as the pointer they wrap, everything else is passed as is.
+template <typename T>
+struct DirectCallType {
+    using type = T;
+    static T const& convert(T const& arg) noexcept {
+        return arg;
     }
-
-    if (!method) {
-        return RunMethodException("Method cannot be null!", nullptr);
+    static T make(T arg) noexcept {
+        return arg;
     }
+};
 
-    auto mPtr = method->methodPointer;
+template <typename T>
+    requires(has_il2cpp_conversion<T>)
+struct DirectCallType<T> {
+    using type = void*;
+    static void* convert(T const& arg) noexcept {
+        return arg.convert();
+    }
+    static T make(void* arg) noexcept {
+        return T(arg);
+    }
+};
 
-    if (!mPtr) {
-        return RunMethodException("Method pointer cannot be null (don't call an abstract method directly!)", method);
+template <typename TOut, typename... TArgs>
+MethodResult<TOut> Il2CppInvoker(Il2CppObject* obj, const MethodInfo* method, TArgs&&... params) noexcept;
+
+/// @brief Invokes the methodPointer of the provided MethodInfo* directly, with the C++ signature described by TOut and TArgs.
+/// The MethodInfo* is always passed as the trailing hidden argument, which is what shared generic code uses to find its generic context.
+/// Value type instances are never boxed: if the methodPointer is an adjustor thunk, the instance pointer is adjusted to look like a boxed object instead.
+/// Return values are never boxed either.
+/// Falls back to Il2CppInvoker (runtime_invoke) if the method has no methodPointer, boxing value type instances for it.
+/// Performs no type checking, besides rejecting void vs. non-void return mismatches.
+/// @param instance The instance to invoke on. For value types, this must point to the unboxed value. Ignored for static methods.
+template <typename TOut, typename T, typename... TArgs>
+MethodResult<TOut> FnPtrInvoker(T* instance, const MethodInfo* method, TArgs&&... params) noexcept {
+    if (!method) {
+        return RunMethodException("Method cannot be null!", nullptr);
     }
 
+    // Calling a void method as non-void would return whatever is left in the return register.
+    // This should ALWAYS fail because it's very wrong, regardless of type checking.
+    bool returnsVoid = method->return_type && method->return_type->type == IL2CPP_TYPE_VOID;
     if constexpr (std::is_same_v<TOut, void>) {
-        // Method has void return
-        if (!il2cpp_functions::type_equals(method->return_type, &il2cpp_functions::defaults->void_class->byval_arg)) {
-            // If the method does NOT have a void return, yet we asked for one, this fails.
-            // This should ALWAYS fail because it's very wrong, regardless of checkTypes.
+        if (!returnsVoid) {
             return RunMethodException("Return type of method is not void, yet was requested as void!", method);
         }
     } else {
-        // Method does not void return
-        if (il2cpp_functions::type_equals(method->return_type, &il2cpp_functions::defaults->void_class->byval_arg)) {
+        if (returnsVoid) {
             return RunMethodException("Return type of method is void, yet was requested as non-void!", method);
         }
     }
 
-    try {
-        if ((method->flags & METHOD_ATTRIBUTE_STATIC) > 0) {
-            // Static method
-            return reinterpret_cast<TOut (*)(std::remove_reference_t<TArgs>..., const MethodInfo*)>(mPtr)(params..., method);
+    bool isStatic = method->flags & METHOD_ATTRIBUTE_STATIC;
+    auto mPtr = method->methodPointer;
+    if (!mPtr) {
+        // Nothing to call directly, let the runtime figure out how to invoke it
+        if (!isStatic && instance && il2cpp_functions::class_is_valuetype(method->klass)) {
+            // runtime_invoke takes the instance as an object, so a value type needs an actual box, whose changes are copied back
+            auto* klass = const_cast<Il2CppClass*>(method->klass);
+            void* value = const_cast<std::remove_cv_t<T>*>(instance);
+            auto* boxed = il2cpp_functions::value_box(klass, value);
+            auto result = Il2CppInvoker<TOut>(boxed, method, std::forward<TArgs>(params)...);
+            std::memcpy(value, il2cpp_functions::object_unbox(boxed), il2cpp_functions::class_value_size(klass, nullptr));
+            return result;
         }
+        return Il2CppInvoker<TOut>(reinterpret_cast<Il2CppObject*>(instance), method, std::forward<TArgs>(params)...);
+    }
 
-        auto castedMPtr = reinterpret_cast<TOut (*)(std::remove_reference_t<TArgs>..., const MethodInfo*)>(mPtr);
-
-        auto boxedRepr = instance;
-        if (il2cpp_functions::class_is_valuetype(method->klass)) {
-            if constexpr (sizeof(Il2CppCodeGenModule) <= 104) {
-                // Boxing is only required if we invoke to adjustor thunks instead of actual impls
-                // Note that for whatever reason, we have exposed methods that are compiled that use literals, yet we still need to passed boxed reprs.
-                if constexpr (il2cpp_type_check::need_box<T>::value) {
-                    // TODO: Eventually remove this dependence on il2cpp_functions::Init
-                    il2cpp_functions::Init();
-                    // Yeah, we cast literally all over the place.
-                    boxedRepr = reinterpret_cast<T*>(il2cpp_functions::value_box(classof(T), boxedRepr));
-                } else {
-                    boxedRepr = reinterpret_cast<T*>(reinterpret_cast<void**>(boxedRepr) - 2);
-                }
+    if (isStatic && method->klass && !method->klass->cctor_finished_or_no_cctor) {
+        il2cpp_functions::Class_Init(method->klass);
+    }
+
+    using RetType = typename DirectCallType<std::remove_cvref_t<TOut>>::type;
+    try {
+        if (isStatic) {
+            auto castedMPtr = reinterpret_cast<RetType (*)(typename DirectCallType<std::remove_cvref_t<TArgs>>::type..., const MethodInfo*)>(mPtr);
+            if constexpr (std::is_same_v<TOut, void>) {
+                castedMPtr(DirectCallType<std::remove_cvref_t<TArgs>>::convert(params)..., method);
+                return MethodResult<TOut>();
+            } else {
+                return DirectCallType<std::remove_cvref_t<TOut>>::make(castedMPtr(DirectCallType<std::remove_cvref_t<TArgs>>::convert(params)..., method));
             }
         }
 
-        // update value type
-        auto unbox_value_type = [&]() {
-            if constexpr (il2cpp_type_check::need_box<T>::value && sizeof(Il2CppCodeGenModule) <= 104) {
-                *instance = *reinterpret_cast<T*>(il2cpp_functions::object_unbox(reinterpret_cast<Il2CppObject*>(boxedRepr)));
+        if (!instance) {
+            return RunMethodException("Method is instance but instance is null!", method);
+        }
+
+        void* self = const_cast<std::remove_cv_t<T>*>(instance);
+        if constexpr (sizeof(Il2CppCodeGenModule) <= 104) {
+            // The methodPointer of a value type instance method is an adjustor thunk, which skips past the object header of a boxed instance.
+            // We don't need an actual box for that, just a pointer that is one object header before our value.
+            if (il2cpp_functions::class_is_valuetype(method->klass)) {
+                self = reinterpret_cast<Il2CppObject*>(self) - 1;
             }
-        };
+        }
 
+        auto castedMPtr = reinterpret_cast<RetType (*)(void*, typename DirectCallType<std::remove_cvref_t<TArgs>>::type..., const MethodInfo*)>(mPtr);
         if constexpr (std::is_same_v<TOut, void>) {
-            castedMPtr(boxedRepr, params..., method);
-            unbox_value_type();
+            castedMPtr(self, DirectCallType<std::remove_cvref_t<TArgs>>::convert(params)..., method);
+            return MethodResult<TOut>();
         } else {
-            TOut res = castedMPtr(boxedRepr, params..., method);
-            unbox_value_type();
-            return res;
+            return DirectCallType<std::remove_cvref_t<TOut>>::make(castedMPtr(self, DirectCallType<std::remove_cvref_t<TArgs>>::convert(params)..., method));
         }
-
     } catch (Il2CppExceptionWrapper& wrapper) {
         return RunMethodException(wrapper.ex, method);
     }
@@ -669,6 +795,8 @@ MethodResult<TOut> Il2CppInvoker(Il2CppObject* obj, const MethodInfo* method, TA
             // probably ref type pointer
             return static_cast<TOut>(static_cast<void*>(ret));
         }
+    } else {
+        return MethodResult<TOut>();
     }
 }
 }  // namespace invokers
@@ -676,6 +804,7 @@ MethodResult<TOut> Il2CppInvoker(Il2CppObject* obj, const MethodInfo* method, TA
 
 
 
+
 template <class TOut = Il2CppObject*, bool checkTypes = true, class T, class... TArgs>
     requires(!::std::is_convertible_v<T, std::string_view> || std::is_same_v<T, nullptr_t>)
 // Runs a MethodInfo with the specified parameters and instance, with return type TOut.
@@ -688,26 +817,8 @@ MethodResult<TOut> RunMethod(T&& wrappedInstance, const MethodInfo* method, TArg
     }
 
     if constexpr (checkTypes) {
-        // only check args if TArgs is > 0
-        if (method->parameters_count != sizeof...(TArgs)) {
-            logger.warn("MethodInfo parameter count {} does not match actual parameter count {}", method->parameters_count, sizeof...(TArgs));
-        }
-
-        if constexpr (sizeof...(TArgs) > 0) {
-            std::array<const Il2CppType*, sizeof...(TArgs)> types{ ::il2cpp_utils::ExtractType(params)... };
-            if (!ParameterMatch(method, types, std::nullopt)) {
-                return RunMethodException("Parameters do not match!", method);
-            }
-        }
-
-        if constexpr (!std::is_same_v<TOut, void>) {
-            auto* outType = ExtractIndependentType<TOut>();
-            if (outType) {
-                if (!IsConvertibleFrom(outType, method->return_type, false)) {
-                    logger.warn("User requested TOut {} does not match the method's return object of type {}!", TypeGetSimpleName(outType), TypeGetSimpleName(method->return_type));
-                    return RunMethodException(fmt::format("Return type of method is not convertible to: {}!", TypeGetSimpleName(outType)), method);
-                }
-            }
+        if (auto exc = CheckMethodTypes<TOut>(method, params...)) {
+            return *exc;
         }
     }
 
@@ -778,6 +889,26 @@ MethodResult<TOut> RunMethod(T&& wrappedInstance, const MethodInfo* method, TArg
     }
 }
 
+template <class TOut = Il2CppObject*, bool checkTypes = true, class T, class... TArgs>
+    requires(!::std::is_convertible_v<T, std::string_view> || std::is_same_v<T, nullptr_t>)
+// Runs a MethodInfo with the specified parameters and instance, with return type TOut, by calling its methodPointer directly.
+// Unlike RunMethod, neither the parameters nor the return value are boxed, see invokers::FnPtrInvoker.
+// Assumes a static method if instance == nullptr.
+MethodResult<TOut> RunMethodDirect(T&& wrappedInstance, const MethodInfo* method, TArgs&&... params) noexcept {
+    if (!method) {
+        return RunMethodException("MethodInfo cannot be null!", nullptr);
+    }
+
+    if constexpr (checkTypes) {
+        if (auto exc = CheckMethodTypes<TOut>(method, params...)) {
+            return *exc;
+        }
+    }
+
+    void* inst = ::il2cpp_utils::ExtractValue(wrappedInstance);  // null is allowed (for T = Il2CppType* or Il2CppClass*)
+    return invokers::FnPtrInvoker<TOut>(inst, method, std::forward<TArgs>(params)...);
+}
+
 template <class TOut = Il2CppObject*, bool checkTypes = true, class T, class... TArgs>
 // Runs a (static) method with the specified method name, with return type TOut.
 // Checks the types of the parameters against the candidate methods.
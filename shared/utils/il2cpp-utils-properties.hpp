@@ -4,6 +4,7 @@
 #pragma pack(push)
 
 #include "il2cpp-functions.hpp"
+#include <array>
 #include <optional>
 #include "il2cpp-utils-methods.hpp"
 
@@ -19,6 +20,8 @@ namespace il2cpp_utils {
     // Returns the PropertyInfo for the property of the given class with the given name
     // Created by zoller27osu
     const PropertyInfo* FindProperty(Il2CppClass* klass, ::std::string_view propertyName);
+    // As FindProperty, but without logging or dumping the class when the property is not found. Misses are cached, see SetLookupMissExpiry
+    const PropertyInfo* TryFindProperty(Il2CppClass* klass, ::std::string_view propertyName);
     // Wrapper for FindProperty taking a namespace and class name in place of an Il2CppClass*
     const PropertyInfo* FindProperty(::std::string_view nameSpace, ::std::string_view className, ::std::string_view propertyName);
     // Wrapper for FindProperty taking an instance to extract the Il2CppClass* from
@@ -87,6 +90,69 @@ namespace il2cpp_utils {
         auto* klass = RET_0_UNLESS(logger, GetClassFromName(nameSpace, className));
         return SetPropertyValue<checkTypes>(klass, propName, value);
     }
+
+    /// @brief A property resolved once, whose getter and setter are then called through their methodPointers directly.
+    /// Unlike GetPropertyValue/SetPropertyValue, a Get or Set does no lookup, locking, type checking or boxing, see RunMethodDirect.
+    /// Resolve it once (ex: as a static local) and reuse it from hot paths.
+    /// @tparam T The C++ type of the property's value.
+    /// @tparam checkTypes Whether to check the getter and setter against T, once, when resolving.
+    template<class T, bool checkTypes = true>
+    struct PropertyHandle {
+        const PropertyInfo* property = nullptr;
+        const MethodInfo* getter = nullptr;
+        const MethodInfo* setter = nullptr;
+
+        PropertyHandle() = default;
+
+        explicit PropertyHandle(const PropertyInfo* prop) : property(prop) {
+            if (!prop) return;
+            il2cpp_functions::Init();
+            auto const& logger = il2cpp_utils::Logger;
+            getter = il2cpp_functions::property_get_get_method(prop);
+            setter = il2cpp_functions::property_get_set_method(prop);
+            if constexpr (checkTypes) {
+                if (getter && CheckMethodTypes<T>(getter)) {
+                    logger.error("PropertyHandle: getter of {} does not return a value convertible to the requested type!", prop->name);
+                    getter = nullptr;
+                }
+                auto* valueType = ExtractIndependentType<T>();
+                if (setter && valueType && !ParameterMatch(setter, std::array<const Il2CppType*, 1>{ valueType }, std::nullopt)) {
+                    logger.error("PropertyHandle: setter of {} does not take the requested type!", prop->name);
+                    setter = nullptr;
+                }
+            }
+        }
+
+        /// @brief Resolves the property with the given name on klass or its parents.
+        PropertyHandle(Il2CppClass* klass, ::std::string_view propName) : PropertyHandle(FindProperty(klass, propName)) {}
+
+        /// @brief Resolves the property with the given name on the class with the given namespace and name.
+        PropertyHandle(::std::string_view nameSpace, ::std::string_view className, ::std::string_view propName)
+            : PropertyHandle(FindProperty(nameSpace, className, propName)) {}
+
+        /// @brief Whether the property was found.
+        explicit operator bool() const noexcept {
+            return property != nullptr;
+        }
+
+        /// @brief Gets the value of the property on instance, or of the static property if instance is nullptr.
+        template<class I = ::std::nullptr_t>
+        MethodResult<T> Get(I&& instance = nullptr) const noexcept {
+            if (!getter) {
+                return RunMethodException("Property has no usable getter!", nullptr);
+            }
+            return RunMethodDirect<T, false>(::std::forward<I>(instance), getter);
+        }
+
+        /// @brief Sets the value of the property on instance, or of the static property if instance is nullptr.
+        template<class I>
+        MethodResult<void> Set(I&& instance, T const& value) const noexcept {
+            if (!setter) {
+                return RunMethodException("Property has no usable setter!", nullptr);
+            }
+            return RunMethodDirect<void, false>(::std::forward<I>(instance), setter, value);
+        }
+    };
 }
 
 #pragma pack(pop)
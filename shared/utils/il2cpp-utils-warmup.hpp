@@ -0,0 +1,52 @@
+#pragma once
+
+#include "inline-function.hpp"
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+struct MethodInfo;
+
+namespace il2cpp_utils {
+    /// @brief Timing of a WarmUp call.
+    struct WarmUpStats {
+        /// @brief Lookups resolved by this call
+        std::size_t resolved = 0;
+        /// @brief Lookups which returned null or threw. They are retried by the next WarmUp.
+        std::size_t failed = 0;
+        std::size_t threads = 0;
+        /// @brief Wall clock time of the whole call
+        std::chrono::microseconds elapsed{};
+        /// @brief Sum of the time spent in each lookup, across all threads
+        std::chrono::microseconds busy{};
+        std::chrono::microseconds slowest{};
+        std::string slowestLabel;
+    };
+
+    /// @brief Registers a lookup to resolve in WarmUp. Safe to call during static initialization.
+    /// @param label Name of the lookup, for logging
+    /// @param resolve Performs the lookup, which is expected to cache its result, returning whether it succeeded
+    void RegisterWarmUp(std::string_view label, InlineFunction<bool()> resolve);
+    /// @brief Registers GetClassFromName(nameSpace, className) to be resolved in WarmUp.
+    void RegisterWarmUpClass(std::string_view nameSpace, std::string_view className);
+    /// @brief Registers FindMethodUnsafe(nameSpace, className, methodName, argsCount) to be resolved in WarmUp.
+    void RegisterWarmUpMethod(std::string_view nameSpace, std::string_view className, std::string_view methodName, int argsCount);
+
+    /// @brief Registers a lookup at static initialization, ex: `static il2cpp_utils::WarmUpRegistration warmUp("MyClass", []{ return classof(MyClass*) != nullptr; });`
+    /// MAKE_HOOK_MATCH hooks register their MethodInfo* lookups this way.
+    struct WarmUpRegistration {
+        WarmUpRegistration(std::string_view label, InlineFunction<bool()> resolve) {
+            RegisterWarmUp(label, std::move(resolve));
+        }
+        WarmUpRegistration(std::string_view label, const MethodInfo* (*getter)()) {
+            RegisterWarmUp(label, [getter]() { return getter() != nullptr; });
+        }
+    };
+
+    /// @brief Resolves every registered lookup which has not been resolved yet, in parallel on threads attached to il2cpp.
+    /// Call it once il2cpp is initialized, ex: in load(), so that lookups do not happen lazily while playing.
+    /// @param threadCount Number of threads to resolve on, or 0 to pick one from the number of cores
+    /// @param progress Called after each lookup with the number of lookups done and the total, from the resolving threads
+    WarmUpStats WarmUp(std::size_t threadCount = 0, InlineFunction<void(std::size_t, std::size_t)> progress = nullptr);
+}
@@ -14,9 +14,13 @@
 #include <future>
 #include <vector>
 #include <unordered_map>
+#include <shared_mutex>
 #include <jni.h>
 
 #include "gc-alloc.hpp"
+#include "hashing.hpp"
+#include "inline-function.hpp"
+#include "lookup-cache.hpp"
 
 #include "il2cpp-functions.hpp"
 #include "logging.hpp"
@@ -28,6 +32,9 @@
 #include "il2cpp-utils-exceptions.hpp"
 #include "il2cpp-utils-properties.hpp"
 #include "il2cpp-utils-fields.hpp"
+#include "il2cpp-utils-members.hpp"
+#include "il2cpp-utils-warmup.hpp"
+#include "il2cpp-utils-dump.hpp"
 #include <string>
 #include <thread>
 #include <string_view>
@@ -39,7 +46,7 @@
 template <>
 struct BS_HOOKS_HIDDEN std::hash<std::pair<Il2CppMethodPointer, bool>> {
     size_t operator()(const std::pair<Il2CppMethodPointer, bool>& p) const {
-        return std::hash<Il2CppMethodPointer>{}(p.first) ^ std::hash<bool>{}(p.first);
+        return std::hash<Il2CppMethodPointer>{}(p.first) ^ std::hash<bool>{}(p.second);
     }
 };
 
@@ -57,6 +64,15 @@ namespace il2cpp_utils {
 
     Il2CppClass* GetParamClass(const MethodInfo* method, int paramIdx);
 
+    // Statistics of the caches behind FindProperty, FindField, FindMethodUnsafe and GetClassFromName
+    hash_table_stats GetPropertyCacheStats();
+    hash_table_stats GetFieldCacheStats();
+    hash_table_stats GetMethodCacheStats();
+    hash_table_stats GetClassNameCacheStats();
+
+    /// @brief Logs bucket usage, probe lengths and hash collisions of the name resolution caches as log(INFO).
+    void LogCacheStats(Paper::LoggerContext const& logger);
+
     /// @brief Clears all allocated delegates.
     /// THIS SHOULD NOT BE CALLED UNLESS YOU ARE CERTAIN ALL ALLOCATED DELEGATES NO LONGER EXIST IN IL2CPP!
     void ClearDelegates();
@@ -71,7 +87,50 @@ namespace il2cpp_utils {
     void AddAllocatedDelegate(std::pair<Il2CppMethodPointer, bool> delegate, MethodInfo* inf);
 
     // Holds a mapping from method pointers and whether it is static or not to method infos.
+    // Only access this while holding delegateMethodInfoMutex.
     extern std::unordered_map<std::pair<Il2CppMethodPointer, bool>, MethodInfo*> delegateMethodInfoMap;
+    // Guards delegateMethodInfoMap.
+    extern std::shared_mutex delegateMethodInfoMutex;
+
+    /// @brief Returns the MethodInfo* for delegates invoking the given method pointer, shared by every delegate with the same invoker.
+    /// On first use it is taken from a pool and filled in from the delegate type's Invoke method.
+    /// There is one per invoker, so it is kept until ClearDelegate. Its address is never reused, so caches keyed by MethodInfo* stay valid.
+    /// @param delegate The method pointer to invoke and whether it is static
+    /// @param invoke The Invoke method of the delegate type
+    /// @return The shared MethodInfo*, which must not be modified or freed
+    const MethodInfo* GetDelegateMethodInfo(std::pair<Il2CppMethodPointer, bool> delegate, const MethodInfo* invoke);
+
+    /// @brief Ties the lifetime of an invoker context to the provided delegate instance: destroy is called with context once the delegate is collected.
+    /// @param instance The delegate instance that uses the context
+    /// @param context The invoker context, passed to destroy
+    /// @param destroy Destroys the context
+    void TrackDelegate(Il2CppDelegate* instance, void* context, void (*destroy)(void*));
+
+    /// @brief Destroys the invoker contexts of tracked delegates which have been collected.
+    /// This is called automatically by TrackDelegate as tracked delegates accumulate.
+    /// @return The number of contexts destroyed
+    std::size_t CollectDelegates();
+
+    /// @brief Allocates and constructs an invoker context (ex: WrapperInstance) for a delegate.
+    /// Contexts are pooled by size and visible to the GC. Pass it to TrackDelegate, or destroy it with DeleteDelegateContext.
+    template<class T, class... TArgs>
+    T* NewDelegateContext(TArgs&&... args) {
+        return new (gc_slab_alloc(sizeof(T))) T(std::forward<TArgs>(args)...);
+    }
+
+    /// @brief Destroys an invoker context allocated with NewDelegateContext.
+    template<class T>
+    void DeleteDelegateContext(T* context) noexcept {
+        if (!context) return;
+        context->~T();
+        gc_slab_free(context, sizeof(T));
+    }
+
+    /// @brief Destroys an invoker context allocated with NewDelegateContext once the delegate instance is collected.
+    template<class T>
+    void TrackDelegate(Il2CppDelegate* instance, T* context) {
+        TrackDelegate(instance, context, [](void* ptr) { DeleteDelegateContext(static_cast<T*>(ptr)); });
+    }
 
     struct __InternalCSStr {
         Il2CppObject object;
@@ -181,7 +240,7 @@ namespace il2cpp_utils {
     template<class I, class R, class... TArgs>
     struct WrapperInstance {
         I rawInstance;
-        std::function<R(I*, TArgs...)> wrappedFunc;
+        InlineFunction<R(I*, TArgs...)> wrappedFunc;
     };
 
     /// @brief The wrapper for an invokable delegate without an existing context.
@@ -189,7 +248,15 @@ namespace il2cpp_utils {
     /// @tparam TArgs The argument types of the function being called.
     template<class R, class... TArgs>
     struct WrapperStatic : Il2CppObject {
-        std::function<R(TArgs...)> wrappedFunc;
+        InlineFunction<R(TArgs...)> wrappedFunc;
+    };
+
+    /// @brief The wrapper for an invokable delegate that stores its callable directly, without type erasure.
+    /// Used with invoker_func_direct, which is instantiated per callable type.
+    /// @tparam F The callable type, usually a lambda.
+    template<class F>
+    struct WrapperDirect : Il2CppObject {
+        F func;
     };
 
     /// @brief The invoker function for a delegate that has a non-trivial context.
@@ -227,12 +294,33 @@ namespace il2cpp_utils {
         )
     }
 
-    /// @brief EXTREMEMLY UNSAFE ALLOCATION! THIS SHOULD BE AVOIDED UNLESS YOU KNOW WHAT YOU ARE DOING!
-    /// This function allocates a GC-able object of the size provided by manipulating an existing Il2CppClass' instance_size.
-    /// This is VERY DANGEROUS (and NOT THREAD SAFE!) and may cause all sorts of race conditions. Use at your own risk.
+    /// @brief The invoker function for a delegate with a directly stored callable, for void delegates with at most 2 arguments.
+    /// As the callable type is known here, it is called without the indirection through wrappedFunc and can be inlined.
+    /// @tparam F The callable type.
+    /// @tparam TArgs The argument types of the function.
+    /// @param instance The wrapped instance of this context function.
+    /// @param args The arguments to pass to this function.
+    template<class F, class... TArgs>
+    requires(sizeof...(TArgs) <= 2 && std::is_void_v<std::invoke_result_t<F&, TArgs...>>)
+    void invoker_func_direct(WrapperDirect<F>* instance, TArgs... args) {
+        IL2CPP_LANDING_PAD_HANDLER(true,
+            instance->func(args...);
+        )
+    }
+
+    /// @brief Allocates a GC-able System.Object instance of at least the size provided.
+    /// The size is taken from a private copy of System.Object's class per size class, so no shared class state is modified and this is thread safe.
+    /// Sizes above 64 bytes are rounded up to a quarter of their power of two, so the object may be up to a quarter larger than requested,
+    /// and at most 104 class copies are ever made. Sizes must not exceed 2GB.
+    /// Only the object header is known to the GC's type information, so references stored past it may not keep their targets alive.
+    /// @param size The size to allocate the object with, including the object header.
+    /// @return The returned GC-allocated instance.
+    void* AllocateSized(std::size_t size);
+
+    /// @brief Allocates a GC-able object of the size provided. Forwards to AllocateSized, which no longer modifies System.Object's instance_size.
     /// @param size The size to allocate the unsafe object with.
     /// @return The returned GC-allocated instance.
-    [[deprecated("DO NOT USE")]] void* __AllocateUnsafe(std::size_t size);
+    [[deprecated("Use AllocateSized")]] void* __AllocateUnsafe(std::size_t size);
 
 
     // Intializes an object (using the given args) fit to be passed to the given method at the given parameter index.
@@ -489,6 +577,7 @@ namespace il2cpp_utils {
             } catch (exceptions::StackTraceException const& e) {
                 logger.error("Exception in thread with thread id {}", thread_id);
                 logger.error("Caught in mod id: " _CATCH_HANDLER_ID ": Uncaught StackTraceException! what(): {}", e.what());
+                e.log_backtrace();
                 SAFE_ABORT();
             } catch (std::exception const& e) {
                 logger.error("Exception in thread with thread id {}", thread_id);
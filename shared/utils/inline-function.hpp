@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace il2cpp_utils {
+    template<class Sig, std::size_t Size = 48>
+    class InlineFunction;
+
+    template<class T>
+    struct is_std_function : std::false_type {};
+
+    template<class Sig>
+    struct is_std_function<std::function<Sig>> : std::true_type {};
+
+    /// @brief A copyable, type erased callable like std::function, which stores callables of up to Size bytes inline instead of allocating.
+    /// Trivially copyable callables (ex: lambdas capturing only pointers and numbers) are copied and destroyed without any indirection.
+    /// Larger callables are stored on the heap, as std::function would.
+    /// @tparam R The return type of the callable.
+    /// @tparam TArgs The argument types of the callable.
+    /// @tparam Size The inline storage size in bytes.
+    template<class R, class... TArgs, std::size_t Size>
+    class InlineFunction<R(TArgs...), Size> {
+        enum class Op { Copy, Move, Destroy };
+        using invoker_t = R (*)(void*, TArgs...);
+        using manager_t = void (*)(Op, void* dst, void* src);
+
+        template<class F>
+        static constexpr bool stored_inline = sizeof(F) <= Size && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+        template<class F>
+        static constexpr bool trivially_managed = stored_inline<F> && std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>;
+
+        alignas(std::max_align_t) std::byte storage[Size];
+        invoker_t invoker = nullptr;
+        // nullptr when empty or when the callable is trivially managed, in which case it is copied bytewise
+        manager_t manager = nullptr;
+
+        template<class F>
+        static F* target(void* storage) noexcept {
+            if constexpr (stored_inline<F>) {
+                return std::launder(reinterpret_cast<F*>(storage));
+            } else {
+                return *reinterpret_cast<F**>(storage);
+            }
+        }
+
+        template<class F>
+        static R invoke(void* storage, TArgs... args) {
+            return std::invoke(*target<F>(storage), std::forward<TArgs>(args)...);
+        }
+
+        template<class F>
+        static void manage(Op op, void* dst, void* src) {
+            switch (op) {
+                case Op::Copy:
+                    if constexpr (stored_inline<F>) {
+                        new (dst) F(*target<F>(src));
+                    } else {
+                        *reinterpret_cast<F**>(dst) = new F(*target<F>(src));
+                    }
+                    break;
+                case Op::Move:
+                    if constexpr (stored_inline<F>) {
+                        new (dst) F(std::move(*target<F>(src)));
+                        target<F>(src)->~F();
+                    } else {
+                        *reinterpret_cast<F**>(dst) = target<F>(src);
+                    }
+                    break;
+                case Op::Destroy:
+                    if constexpr (stored_inline<F>) {
+                        target<F>(dst)->~F();
+                    } else {
+                        delete target<F>(dst);
+                    }
+                    break;
+            }
+        }
+
+        template<class F, class... CArgs>
+        void emplace(CArgs&&... args) {
+            if constexpr (stored_inline<F>) {
+                new (storage) F(std::forward<CArgs>(args)...);
+            } else {
+                *reinterpret_cast<F**>(storage) = new F(std::forward<CArgs>(args)...);
+            }
+            invoker = &invoke<F>;
+            if constexpr (!trivially_managed<F>) {
+                manager = &manage<F>;
+            }
+        }
+
+        void copy_from(InlineFunction const& other) {
+            if (other.manager) {
+                other.manager(Op::Copy, storage, const_cast<std::byte*>(other.storage));
+            } else {
+                std::memcpy(storage, other.storage, Size);
+            }
+            invoker = other.invoker;
+            manager = other.manager;
+        }
+
+        void move_from(InlineFunction& other) noexcept {
+            if (other.manager) {
+                other.manager(Op::Move, storage, other.storage);
+            } else {
+                std::memcpy(storage, other.storage, Size);
+            }
+            invoker = other.invoker;
+            manager = other.manager;
+            other.invoker = nullptr;
+            other.manager = nullptr;
+        }
+
+       public:
+        InlineFunction() noexcept = default;
+        InlineFunction(std::nullptr_t) noexcept {}
+
+        template<class F>
+        requires(!std::is_same_v<std::decay_t<F>, InlineFunction> && std::is_copy_constructible_v<std::decay_t<F>> && std::is_invocable_r_v<R, std::decay_t<F>&, TArgs...>)
+        InlineFunction(F&& f) {
+            using Fd = std::decay_t<F>;
+            // Null function pointers, member pointers and empty std::functions construct an empty InlineFunction, as with std::function
+            if constexpr (!std::is_function_v<std::remove_reference_t<F>> && (std::is_pointer_v<Fd> || std::is_member_pointer_v<Fd> || is_std_function<Fd>::value)) {
+                if (!f) return;
+            }
+            emplace<Fd>(std::forward<F>(f));
+        }
+
+        InlineFunction(InlineFunction const& other) { copy_from(other); }
+        InlineFunction(InlineFunction&& other) noexcept { move_from(other); }
+
+        InlineFunction& operator=(InlineFunction const& other) {
+            if (this != &other) {
+                InlineFunction copy(other);
+                reset();
+                move_from(copy);
+            }
+            return *this;
+        }
+
+        InlineFunction& operator=(InlineFunction&& other) noexcept {
+            if (this != &other) {
+                reset();
+                move_from(other);
+            }
+            return *this;
+        }
+
+        InlineFunction& operator=(std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+        template<class F>
+        requires(!std::is_same_v<std::decay_t<F>, InlineFunction> && std::is_constructible_v<InlineFunction, F>)
+        InlineFunction& operator=(F&& f) {
+            return *this = InlineFunction(std::forward<F>(f));
+        }
+
+        ~InlineFunction() { reset(); }
+
+        void reset() noexcept {
+            if (manager) {
+                manager(Op::Destroy, storage, nullptr);
+            }
+            invoker = nullptr;
+            manager = nullptr;
+        }
+
+        explicit operator bool() const noexcept { return invoker != nullptr; }
+
+        /// @brief Calls the stored callable, throwing std::bad_function_call if there is none.
+        R operator()(TArgs... args) const {
+            if (!invoker) throw std::bad_function_call();
+            return invoker(const_cast<std::byte*>(storage), std::forward<TArgs>(args)...);
+        }
+    };
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+
+struct Il2CppClass;
+
+namespace il2cpp_utils {
+    using lookup_clock = std::chrono::steady_clock;
+
+    /// @brief Sets how long a failed FindField/FindProperty/FindMethod lookup is remembered.
+    /// Until it expires, repeating the lookup returns nullptr after a single cache probe, without searching or logging again.
+    /// Misses from TryFindField/TryFindProperty/TryFindMethod are not logged, so they are only reused by other TryFind lookups:
+    /// the first FindField/FindProperty/FindMethod of the member still searches and logs the miss.
+    /// Misses expire (30 seconds by default) so members which are registered later are still found.
+    void SetLookupMissExpiry(std::chrono::milliseconds expiry) noexcept;
+    std::chrono::milliseconds GetLookupMissExpiry() noexcept;
+
+    /// @brief Whether the members of klass should be dumped to the log after a failed lookup.
+    /// Each class is dumped at most once per kind of member per miss expiry, so probing several missing members does not flood the log.
+    /// @param kind The kind of member which was not found, ex: 'f' for fields, 'p' for properties, 'm' for methods.
+    bool ShouldDumpLookupMiss(const Il2CppClass* klass, char kind) noexcept;
+
+    /// @brief A cached member lookup: either the member which was found, or a miss which expires.
+    template<class T>
+    struct lookup_entry {
+        T value = nullptr;
+        lookup_clock::time_point missExpiry{};
+        // Whether the miss was logged, so a silent TryFind miss does not suppress the first logged diagnostic
+        bool logged = false;
+
+        static lookup_entry hit(T value) noexcept {
+            return { value, {}, false };
+        }
+        static lookup_entry miss(bool logged) noexcept {
+            return { nullptr, lookup_clock::now() + GetLookupMissExpiry(), logged };
+        }
+
+        bool is_miss() const noexcept {
+            return value == nullptr;
+        }
+        /// @brief Whether the entry can still be returned. Hits never expire, so only misses read the clock.
+        /// @param logMisses Whether the lookup logs misses, in which case only misses which were logged can be returned.
+        bool valid(bool logMisses) const noexcept {
+            if (value != nullptr) return true;
+            return (logged || !logMisses) && lookup_clock::now() < missExpiry;
+        }
+    };
+
+    template<class T>
+    lookup_entry<T> make_lookup_entry(T value, bool logMisses) noexcept {
+        return value ? lookup_entry<T>::hit(value) : lookup_entry<T>::miss(logMisses);
+    }
+}
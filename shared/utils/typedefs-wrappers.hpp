@@ -10,6 +10,7 @@
 #include <unordered_set>
 #include <utility>
 #include "base-wrapper-type.hpp"
+#include "gc-alloc.hpp"
 #include "il2cpp-functions.hpp"
 #include "il2cpp-type-check.hpp"
 #include "il2cpp-utils-exceptions.hpp"
@@ -281,7 +282,7 @@ struct SafePtr {
             if (!il2cpp_functions::hasGCFuncs) {
                 SAFE_ABORT_MSG("Cannot use SafePtr without GC functions!");
             }
-            il2cpp_functions::GC_free(internalHandle.__internal_get());
+            gc_slab_free(internalHandle.__internal_get(), sizeof(SafePointerWrapper));
             #endif
         }
     }
@@ -431,14 +432,10 @@ struct SafePtr {
     struct SafePointerWrapper {
         static SafePointerWrapper* New(T* instance) {
             il2cpp_functions::Init();
-            // It should be safe to assume that gc_alloc_fixed returns a non-null pointer. If it does return null, we have a pretty big issue.
-            static constexpr auto sz = sizeof(SafePointerWrapper);
-
             #ifdef UNITY_2021
-            auto* wrapper = reinterpret_cast<SafePointerWrapper*>(il2cpp_functions::gc_alloc_fixed(sz));
-
+            // It should be safe to assume that gc_alloc_fixed returns a non-null pointer. If it does return null, we have a pretty big issue.
+            auto* wrapper = reinterpret_cast<SafePointerWrapper*>(il2cpp_functions::gc_alloc_fixed(sizeof(SafePointerWrapper)));
             #else
-
             if (!il2cpp_functions::hasGCFuncs) {
                 #if __has_feature(cxx_exceptions)
                 throw CreatedTooEarlyException();
@@ -446,7 +443,9 @@ struct SafePtr {
                 SAFE_ABORT_MSG("Cannot use a SafePtr this early/without GC functions!");
                 #endif
             }
-            auto* wrapper = reinterpret_cast<SafePointerWrapper*>(il2cpp_functions::GarbageCollector_AllocateFixed(sz, nullptr));
+            // Wrappers are tiny and short lived, so they come from the slab allocator instead of a GC allocation each.
+            // With the GC functions found, the slab only hands out memory the GC scans.
+            auto* wrapper = reinterpret_cast<SafePointerWrapper*>(gc_slab_alloc(sizeof(SafePointerWrapper)));
             #endif
 
             CRASH_UNLESS(wrapper);
@@ -95,6 +95,39 @@ namespace backtrace_helpers {
     };
     _Unwind_Reason_Code unwindCallback(struct _Unwind_Context *context, void *arg);
     size_t captureBacktrace(void **buffer, uint16_t max, uint16_t skip = 0);
+
+    /// @brief The result of resolving an address within a loaded module.
+    struct SymbolInfo {
+        /// @brief The address that was resolved.
+        void const* addr;
+        /// @brief Path of the module containing the address, nullptr if the address could not be resolved.
+        const char* module;
+        /// @brief Load base of the module containing the address.
+        uintptr_t moduleBase;
+        /// @brief Offset of the address relative to the module base, suitable for offline symbolization.
+        uintptr_t offset;
+        /// @brief Hex encoded GNU build-id of the module, empty if the module has none.
+        std::string_view buildId;
+        /// @brief Demangled name of the nearest symbol, empty if there is none.
+        std::string symbol;
+        /// @brief Offset of the address relative to the nearest symbol, 0 if there is none.
+        uintptr_t symbolOffset;
+    };
+    /// @brief Resolves the provided address with dladdr, caching the result for the lifetime of the process.
+    /// Lookups of cached addresses are lock-free. The returned reference remains valid for the lifetime of the process,
+    /// unless the cache is full, in which case it is only valid until the next call to symbolize on the same thread.
+    SymbolInfo const& symbolize(void const* addr);
+
+    /// @brief Identifies a distinct backtrace and how many times it has been recorded.
+    struct TraceRecord {
+        /// @brief Hash of the frames of the backtrace.
+        uint64_t hash;
+        /// @brief Number of times a backtrace with this hash has been recorded, including this one.
+        /// 0 if the backtrace could not be tracked, in which case it should be treated as never seen before.
+        uint32_t occurrences;
+    };
+    /// @brief Records an occurrence of the provided backtrace, deduplicating identical backtraces by hash. Lock-free.
+    TraceRecord recordBacktrace(void* const* frames, uint16_t size);
 }
 
 #endif /* UTILS_FUNCTIONS_H */
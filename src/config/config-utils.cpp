@@ -5,11 +5,25 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "../../shared/config/config-utils.hpp"
 #include "scotland2/shared/loader.hpp"
 #include "scotland2/shared/modloader.h"
@@ -22,6 +36,258 @@ decltype(Configuration::configDir) Configuration::configDir;
 
 using namespace rapidjson;
 
+namespace {
+    // Writes text to a temporary file next to path and renames it over path, so path is either the old or the new contents
+    bool writefileAtomic(std::string const& path, std::string_view text) {
+        auto tmpPath = path + ".tmp";
+        auto* file = fopen(tmpPath.c_str(), "wb");
+        if (!file) {
+            il2cpp_utils::Logger.error("Failed to open {} for writing: {}", tmpPath, strerror(errno));
+            return false;
+        }
+        bool written = fwrite(text.data(), 1, text.size(), file) == text.size() && fflush(file) == 0 && fsync(fileno(file)) == 0;
+        written = fclose(file) == 0 && written;
+        if (!written || rename(tmpPath.c_str(), path.c_str()) != 0) {
+            il2cpp_utils::Logger.error("Failed to write config {}: {}", path, strerror(errno));
+            remove(tmpPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // A private, writable mapping of a whole file which is null terminated, so it can be parsed in situ.
+    // Files without room for the terminator in their last page are read into a buffer instead.
+    struct FileMapping {
+        char* data = nullptr;
+        std::size_t size = 0;
+        std::size_t mappedLength = 0;
+        std::vector<char> buffer;
+
+        FileMapping() = default;
+        FileMapping(FileMapping const&) = delete;
+        ~FileMapping() { reset(); }
+
+        void reset() {
+            if (mappedLength) munmap(data, mappedLength);
+            data = nullptr;
+            size = 0;
+            mappedLength = 0;
+            buffer.clear();
+        }
+
+        bool open(std::string const& path) {
+            reset();
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return false;
+            struct stat st;
+            if (fstat(fd, &st) != 0) {
+                close(fd);
+                return false;
+            }
+            size = st.st_size;
+            // Past the end of the file, the rest of the last page reads as zeroes
+            if (size % sysconf(_SC_PAGESIZE) != 0) {
+                auto* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (mapped != MAP_FAILED) {
+                    close(fd);
+                    data = static_cast<char*>(mapped);
+                    mappedLength = size;
+                    return true;
+                }
+            }
+            buffer.resize(size + 1);
+            std::size_t read = 0;
+            while (read < size) {
+                auto n = pread(fd, buffer.data() + read, size - read, read);
+                if (n <= 0) break;
+                read += n;
+            }
+            close(fd);
+            buffer[read] = '\0';
+            data = buffer.data();
+            size = read;
+            return true;
+        }
+    };
+
+    long long elapsedMicros(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+}  // namespace
+
+// Two arenas the config is parsed into, alternating between reloads so the current config stays intact until a reload succeeds.
+// Each arena keeps its first chunk, sized by the previous parse, so later reloads allocate at most once.
+struct Configuration::LoadArenas {
+    struct Arena {
+        std::vector<char> chunk;
+        std::optional<MemoryPoolAllocator<>> allocator;
+        // In situ parsing leaves the config's strings in the mapping
+        FileMapping file;
+
+        void release() {
+            allocator.reset();
+            file.reset();
+        }
+    };
+    std::array<Arena, 2> arenas;
+    std::size_t current = 0;
+    std::size_t lastUsed = 0;
+};
+
+// A Configuration's registration with the writer thread, which is shared by every Configuration.
+// Write snapshots the config into its path's queue, and the snapshot is serialized and written once the deadline passes.
+struct Configuration::AsyncWriter {
+    // Pending state for one config file, shared by every Configuration writing to it
+    struct PathQueue {
+        std::string filePath;
+        // Held while writing the file, so writes to it happen in order
+        std::mutex ioMutex;
+        // Only accessed with ioMutex held
+        std::string lastWritten;
+        // The snapshot written next and the Configuration it was taken from, guarded by the thread's mutex
+        std::unique_ptr<ConfigDocument> pending;
+        AsyncWriter* source = nullptr;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    struct Thread {
+        // Guards queues, every queue's pending state, and writing
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::condition_variable done;
+        // Never erased, so references to queues stay valid
+        std::unordered_map<std::string, PathQueue> queues;
+        // The queue being written by the thread, which a Flush to the same path must wait for
+        PathQueue* writing = nullptr;
+
+        Thread() { std::thread(&Thread::run, this).detach(); }
+
+        void run();
+    };
+
+    // Leaked, so configs can still be written by static destructors
+    static Thread& thread() {
+        static auto* instance = new Thread();
+        return *instance;
+    }
+
+    PathQueue& queue;
+    std::atomic<std::size_t> skipped = 0;
+
+    static PathQueue& queueFor(std::string const& path) {
+        auto& t = thread();
+        std::lock_guard lock(t.mutex);
+        auto [itr, inserted] = t.queues.try_emplace(path);
+        if (inserted) itr->second.filePath = path;
+        return itr->second;
+    }
+
+    AsyncWriter(std::string const& path) : queue(queueFor(path)) {}
+
+    ~AsyncWriter() { cancel(); }
+
+    void schedule(ConfigDocument const& config, std::chrono::milliseconds delay) {
+        // Copy on the caller's thread, so the config can keep being modified while this is written
+        auto snapshot = std::make_unique<ConfigDocument>();
+        snapshot->CopyFrom(config, snapshot->GetAllocator());
+        auto& t = thread();
+        {
+            std::lock_guard lock(t.mutex);
+            // A pending write to this path, from this or another Configuration, is replaced
+            if (queue.pending) queue.source->skipped++;
+            queue.pending = std::move(snapshot);
+            queue.source = this;
+            queue.deadline = std::chrono::steady_clock::now() + delay;
+        }
+        t.changed.notify_all();
+    }
+
+    // Takes this writer's pending snapshot off its queue, once the thread is no longer writing to the same path
+    std::unique_ptr<ConfigDocument> cancel() {
+        auto& t = thread();
+        std::unique_lock lock(t.mutex);
+        t.done.wait(lock, [&] { return t.writing != &queue; });
+        if (queue.source != this) return nullptr;
+        queue.source = nullptr;
+        return std::move(queue.pending);
+    }
+
+    void flush() {
+        if (auto doc = cancel()) write(queue, *doc, skipped);
+    }
+
+    static void write(PathQueue& queue, ConfigDocument const& doc, std::atomic<std::size_t>& skipped) {
+        StringBuffer buf;
+        PrettyWriter<StringBuffer> writer(buf);
+        doc.Accept(writer);
+        std::string_view text(buf.GetString(), buf.GetSize());
+        std::lock_guard io(queue.ioMutex);
+        if (text == queue.lastWritten) {
+            skipped++;
+            return;
+        }
+        if (writefileAtomic(queue.filePath, text)) {
+            queue.lastWritten = text;
+        }
+    }
+};
+
+void Configuration::AsyncWriter::Thread::run() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        PathQueue* due = nullptr;
+        std::optional<std::chrono::steady_clock::time_point> next;
+        for (auto& [path, q] : queues) {
+            if (!q.pending) continue;
+            if (q.deadline <= now) {
+                due = &q;
+                break;
+            }
+            if (!next || q.deadline < *next) next = q.deadline;
+        }
+        if (!due) {
+            // Each Write moves its queue's deadline back, so this wakes on every change
+            if (next) {
+                changed.wait_until(lock, *next);
+            } else {
+                changed.wait(lock);
+            }
+            continue;
+        }
+        auto doc = std::move(due->pending);
+        // Kept alive until writing is cleared, as its destructor waits for that
+        auto* source = std::exchange(due->source, nullptr);
+        writing = due;
+        lock.unlock();
+        write(*due, *doc, source->skipped);
+        doc.reset();
+        lock.lock();
+        writing = nullptr;
+        done.notify_all();
+    }
+}
+
+Configuration::Configuration(const modloader::ModInfo& info_) : info(info_) {
+    filePath = Configuration::getConfigFilePath(info_);
+}
+
+// other is flushed before any of its members are moved, as its pending write needs its path
+Configuration::Configuration(Configuration&& other) : info((other.Flush(), std::move(other.info))), filePath(std::move(other.filePath)), arenas(std::move(other.arenas)) {
+    config.Swap(other.config);
+}
+
+Configuration::Configuration(const Configuration& other) : info(other.info), filePath(other.filePath) {
+    // Copy the strings too, as other's point into its file mapping, which goes away on its next reload or destruction
+    config.CopyFrom(other.config, config.GetAllocator(), true);
+}
+
+Configuration::~Configuration() {
+    Flush();
+    // Release the config's values before the arena they live in
+    ConfigDocument().Swap(config);
+}
+
 bool Configuration::ensureObject() {
     if (!config.IsObject()) {
         il2cpp_utils::Logger.warn("Config data for mod was invalid! Clearing.");
@@ -44,29 +310,73 @@ void Configuration::Load() {
 }
 
 void Configuration::Reload() {
-    readJson = parsejsonfile(config, filePath);
+    Flush();
+    auto start = std::chrono::steady_clock::now();
+    if (!arenas) {
+        arenas = std::make_unique<LoadArenas>();
+    }
+    auto next = 1 - arenas->current;
+    auto& arena = arenas->arenas[next];
+    arena.release();
+    if (!arena.file.open(filePath)) {
+        readJson = false;
+        ensureObject();
+        return;
+    }
+    // Values take roughly the size of the file, and the chunk grows to what the last parse needed
+    arena.chunk.resize(std::max({ arena.chunk.size(), arenas->lastUsed, arena.file.size, std::size_t(1024) }));
+    arena.allocator.emplace(arena.chunk.data(), arena.chunk.size());
+    auto mapped = elapsedMicros(start);
+
+    ConfigDocument doc(&*arena.allocator);
+    readJson = !doc.ParseInsitu(arena.file.data).HasParseError();
+    if (readJson) {
+        config.Swap(doc);
+        arenas->current = next;
+        arenas->lastUsed = arena.allocator->Size();
+    } else {
+        il2cpp_utils::Logger.error("Failed to parse config {}: error {} at offset {}", filePath, static_cast<int>(doc.GetParseError()), doc.GetErrorOffset());
+    }
+    // Swapping left doc with the previous config, whose arena can go once it is destroyed
+    ConfigDocument().Swap(doc);
+    if (readJson) {
+        arenas->arenas[1 - next].release();
+    } else {
+        arena.release();
+    }
     ensureObject();
+    il2cpp_utils::Logger.info("Loaded config {} ({} bytes) in {}us, {}us of which mapping", filePath, arena.file.size, elapsedMicros(start), mapped);
 }
 
 void Configuration::Write() {
     ensureObject();
 
-    StringBuffer buf;
-    PrettyWriter<StringBuffer> writer(buf);
-    config.Accept(writer);
-    writefile(filePath, buf.GetString());
+    if (!writer) {
+        writer = std::make_unique<AsyncWriter>(filePath);
+    }
+    writer->schedule(config, writeDelay);
+}
+
+void Configuration::Flush() {
+    if (writer) {
+        writer->flush();
+    }
+}
+
+std::size_t Configuration::SkippedWrites() const {
+    return writer ? writer->skipped.load() : 0;
 }
 
 bool parsejsonfile(ConfigDocument& doc, std::string_view filename) {
     if (!fileexists(filename.data())) {
         return false;
     }
-    std::ifstream is;
-    is.open(filename.data());
-
-    IStreamWrapper wrapper{ is };
-
-    return !doc.ParseStream(wrapper).HasParseError();
+    FileMapping file;
+    if (!file.open(std::string(filename))) {
+        return false;
+    }
+    // The mapping is released on return, so the strings are copied into doc
+    return !doc.Parse(file.data, file.size).HasParseError();
 }
 
 bool parsejson(ConfigDocument& doc, std::string_view js) {
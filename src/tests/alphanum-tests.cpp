@@ -0,0 +1,57 @@
+#ifdef TEST_ALPHANUM
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "shared/utils/alphanum.hpp"
+
+// the precomputed keys order strings as alphanum_comp does
+static void test_keys() {
+    const char* strings[] = { "", "a", "9", "1", "2", "a1", "a2", "a10", "a1a2", "a1a3", "134", "122", "12a3", "aa", "aaa",
+                              "Alpha 2", "Alpha 2A", "Alpha 2 B", "Alpha 200", "z01.doc", "z1.doc", "z10.doc", "List`1<System.Int32>", "List`10" };
+    for (auto* l : strings) {
+        for (auto* r : strings) {
+            int comp = doj::alphanum_comp(l, r);
+            auto lKey = doj::alphanum_key(l), rKey = doj::alphanum_key(r);
+            assert((comp < 0) == (lKey < rKey));
+            assert((comp > 0) == (rKey < lKey));
+        }
+    }
+}
+
+// sorts 100k generic class names with alphanum_less and with alphanum_sort
+static void bench_sort() {
+    const char* namespaces[] = { "System.Collections.Generic.", "UnityEngine.", "GlobalNamespace.", "System.", "Zenject." };
+    const char* types[] = { "List`1", "Dictionary`2", "HashSet`1", "KeyValuePair`2", "Action`3", "Func`4", "ValueTuple`7" };
+    const char* args[] = { "System.Int32", "System.String", "UnityEngine.Vector3", "GlobalNamespace.NoteController", "System.Single", "System.Object" };
+
+    std::mt19937 rng(0);
+    std::vector<std::string> names;
+    names.reserve(100000);
+    for (int i = 0; i < 100000; i++) {
+        std::string name = std::string(namespaces[rng() % std::size(namespaces)]) + types[rng() % std::size(types)] + "<";
+        for (int j = 0, count = 1 + rng() % 3; j < count; j++) {
+            if (j) name += ", ";
+            name += args[rng() % std::size(args)];
+            if (rng() % 3 == 0) name += std::to_string(rng() % 200);
+        }
+        names.push_back(name + ">");
+    }
+
+    auto compared = names;
+    auto start = std::chrono::steady_clock::now();
+    std::sort(compared.begin(), compared.end(), doj::alphanum_less<std::string>());
+    auto comparatorTime = std::chrono::steady_clock::now() - start;
+
+    auto keyed = names;
+    start = std::chrono::steady_clock::now();
+    doj::alphanum_sort(std::span(keyed));
+    auto keyTime = std::chrono::steady_clock::now() - start;
+
+    for (std::size_t i = 0; i < names.size(); i++) {
+        assert(doj::alphanum_comp(compared[i], keyed[i]) == 0);
+    }
+    std::cout << "alphanum_less: " << std::chrono::duration_cast<std::chrono::microseconds>(comparatorTime).count() << "us, alphanum_sort: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(keyTime).count() << "us" << std::endl;
+}
+#endif
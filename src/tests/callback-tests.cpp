@@ -18,4 +18,82 @@ static void randomRunner() {
     asdf.removeCallback(test);
     asdf.invoke();
 }
+
+#include "../../shared/utils/il2cpp-utils.hpp"
+static void delegateTarget() {}
+
+static bool contextDestroyed = false;
+
+// Not inlined, so that no reference to the delegate is left on the caller's stack
+[[gnu::noinline]] static void trackUnreachableDelegate() {
+    auto* klass = CRASH_UNLESS(il2cpp_utils::GetClassFromName("System", "Action"));
+    auto* delegate = reinterpret_cast<Il2CppDelegate*>(il2cpp_functions::object_new(klass));
+    il2cpp_utils::TrackDelegate(delegate, il2cpp_utils::NewDelegateContext<int>(1), [](void* ptr) {
+        contextDestroyed = true;
+        il2cpp_utils::DeleteDelegateContext(static_cast<int*>(ptr));
+    });
+}
+
+static void test_delegate_pool() {
+    using namespace il2cpp_utils;
+    auto* invoke = CRASH_UNLESS(FindMethod("System", "Action", "Invoke"));
+    std::pair<Il2CppMethodPointer, bool> key{ reinterpret_cast<Il2CppMethodPointer>(&delegateTarget), true };
+    // Delegates with the same invoker share one MethodInfo*
+    auto* first = GetDelegateMethodInfo(key, invoke);
+    auto* second = GetDelegateMethodInfo(key, invoke);
+    CRASH_UNLESS(first == second && first->methodPointer == key.first);
+    // Contexts are pooled by size and must be deleted through DeleteDelegateContext
+    auto* context = NewDelegateContext<WrapperInstance<int, void>>(WrapperInstance<int, void>{ 5, [](int* x) { (*x)++; } });
+    context->wrappedFunc(&context->rawInstance);
+    CRASH_UNLESS(context->rawInstance == 6);
+    DeleteDelegateContext(context);
+    // Cleared MethodInfo*s are never handed out again, so caches keyed by them cannot alias a new delegate
+    ClearDelegate(key);
+    CRASH_UNLESS(GetDelegateMethodInfo(key, invoke) != first);
+    ClearDelegate(key);
+
+    // A tracked context is destroyed once its delegate is collected
+    trackUnreachableDelegate();
+    il2cpp_functions::gc_collect(0);
+    CollectDelegates();
+    CRASH_UNLESS(contextDestroyed);
+}
+
+#include <chrono>
+template<class Ctx>
+static void bench_delegate(const char* label, void (*invoker)(Ctx*, int), Ctx* context) {
+    constexpr int iterations = 1000000;
+    // Call through a volatile pointer, as il2cpp would, so the invoker cannot be inlined into the loop
+    void (*volatile fn)(Ctx*, int) = invoker;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        fn(context, i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    il2cpp_utils::Logger.info("{}: {} calls in {}ns ({:.3f}ns/call)", label, iterations, elapsed.count(), (double)elapsed.count() / iterations);
+}
+
+template<class R, class... TArgs>
+static R stdFunctionInvoker(std::function<R(TArgs...)>* func, TArgs... args) {
+    return (*func)(args...);
+}
+
+// Compares the type erased and direct invokers for a void(int) delegate capturing a pointer and an int
+static void bench_delegates() {
+    using namespace il2cpp_utils;
+    int64_t sum = 0;
+    int scale = 3;
+    auto lambda = [&sum, scale](int x) { sum += x * scale; };
+
+    std::function<void(int)> func(lambda);
+    bench_delegate("std::function", &stdFunctionInvoker<void, int>, &func);
+
+    WrapperStatic<void, int> wrapped{};
+    wrapped.wrappedFunc = lambda;
+    bench_delegate("invoker_func_static", &invoker_func_static<void, int>, &wrapped);
+
+    WrapperDirect<decltype(lambda)> direct{ {}, lambda };
+    bench_delegate("invoker_func_direct", &invoker_func_direct<decltype(lambda), int>, &direct);
+    il2cpp_utils::Logger.info("sum: {}", sum);
+}
 #endif
\ No newline at end of file
@@ -0,0 +1,178 @@
+#ifdef TEST_CAPSTONE
+#include <array>
+#include "../../shared/utils/capstone-utils.hpp"
+#include "../../shared/utils/il2cpp-functions.hpp"
+
+using namespace cs::decode;
+
+static constexpr uint64_t pc = 0x1000;
+
+// bl #0x100
+static_assert(decode(0x94000040, pc).kind == Kind::Bl);
+static_assert(decode(0x94000040, pc).imm == 0x1100);
+// b #-4
+static_assert(decode(0x17FFFFFF, pc).kind == Kind::B);
+static_assert(decode(0x17FFFFFF, pc).imm == 0xFFC);
+// b.eq #8, b.ne #-4 (capstone reports both as ARM64_INS_B)
+static_assert(decode(0x54000040, pc).kind == Kind::BCond);
+static_assert(decode(0x54000040, pc).imm == 0x1008);
+static_assert(decode(0x54FFFFE1, pc).kind == Kind::BCond);
+static_assert(decode(0x54FFFFE1, pc).imm == 0xFFC);
+// ret, br x17, blr x8
+static_assert(decode(0xD65F03C0, pc).kind == Kind::Ret);
+static_assert(decode(0xD65F03C0, pc).rd == ARM64_REG_X30);
+static_assert(decode(0xD61F0220, pc).kind == Kind::Br);
+static_assert(decode(0xD61F0220, pc).rd == ARM64_REG_X17);
+static_assert(decode(0xD63F0100, pc).kind == Kind::Blr);
+// adrp x8, #0x12346000 (from pc 0x1234)
+static_assert(decode(0xB0091A28, 0x1234).kind == Kind::Adrp);
+static_assert(decode(0xB0091A28, 0x1234).rd == ARM64_REG_X8);
+static_assert(decode(0xB0091A28, 0x1234).imm == 0x12346000);
+// adr x0, #-8
+static_assert(decode(0x10FFFFC0, pc).kind == Kind::Adr);
+static_assert(decode(0x10FFFFC0, pc).imm == 0xFF8);
+// add x8, x8, #0x10
+static_assert(decode(0x91004108, pc).kind == Kind::AddImm);
+static_assert(decode(0x91004108, pc).rn == ARM64_REG_X8);
+static_assert(decode(0x91004108, pc).imm == 0x10);
+// add w0, w1, #1, lsl #12
+static_assert(decode(0x11400420, pc).rd == ARM64_REG_W0);
+static_assert(decode(0x11400420, pc).imm == 0x1000);
+// mov x29, sp is an alias of add x29, sp, #0
+static_assert(decode(0x910003FD, pc).kind == Kind::Other);
+// ldr x0, [x8, #0x18]
+static_assert(decode(0xF9400D00, pc).kind == Kind::LdrImm);
+static_assert(decode(0xF9400D00, pc).rd == ARM64_REG_X0);
+static_assert(decode(0xF9400D00, pc).rn == ARM64_REG_X8);
+static_assert(decode(0xF9400D00, pc).imm == 0x18);
+// ldr w1, [sp, #4]
+static_assert(decode(0xB94007E1, pc).rd == ARM64_REG_W1);
+static_assert(decode(0xB94007E1, pc).rn == ARM64_REG_SP);
+static_assert(decode(0xB94007E1, pc).imm == 4);
+// stp x29, x30, [sp, #-16]!, ldr x0, #8 (literal) and add x0, x1, x2 are left to capstone
+static_assert(decode(0xA9BF7BFD, pc).kind == Kind::Unknown);
+static_assert(decode(0x58000040, pc).kind == Kind::Unknown);
+static_assert(decode(0x8B020020, pc).kind == Kind::Unknown);
+// nop, movz x0, #1
+static_assert(decode(0xD503201F, pc).kind == Kind::Other);
+static_assert(decode(0xD2800020, pc).kind == Kind::Other);
+
+static void testSearch() {
+    // stp x29, x30, [sp, #-16]!; bl #8; nop; bl #-8; adrp x8, #0; add x8, x8, #0x10; ldr x0, [x8, #0x18]; ret; bl #0
+    std::array<uint32_t, 9> code{ 0xA9BF7BFD, 0x94000002, 0xD503201F, 0x97FFFFFE, 0x90000008, 0x91004108, 0xF9400D00, 0xD65F03C0, 0x94000000 };
+    auto* base = code.data();
+
+    auto secondBl = cs::findNthBl<2, false, -1, sizeof(code)>(base);
+    CRASH_UNLESS(secondBl && *secondBl == base + 1);
+    // The 3rd bl is after the first ret
+    CRASH_UNLESS(!(cs::findNthBl<3, false, 0, sizeof(code)>(base)));
+    CRASH_UNLESS(cs::findNthBl<3, false, 1, sizeof(code)>(base));
+
+    auto pcrel = cs::findNthPcRel<1, -1, sizeof(code)>(base);
+    CRASH_UNLESS(pcrel && std::get<0>(*pcrel) == base + 4 && std::get<1>(*pcrel) == ARM64_REG_X8);
+
+    auto pcaddr = cs::getpcaddr<1, 1, sizeof(code)>(base);
+    CRASH_UNLESS(pcaddr && std::get<0>(*pcaddr) == base + 5);
+    CRASH_UNLESS(reinterpret_cast<uintptr_t>(std::get<2>(*pcaddr)) == (reinterpret_cast<uintptr_t>(base + 4) & ~uintptr_t(0xFFF)) + 0x10);
+}
+
+static void testBCond() {
+    // b.ne #8; nop; b #8; nop; ret
+    std::array<uint32_t, 5> code{ 0x54000041, 0xD503201F, 0x14000002, 0xD503201F, 0xD65F03C0 };
+    auto* base = code.data();
+
+    // B.cond counts as a B, as it did when searching with capstone
+    auto first = cs::findNthB<1, false, -1, sizeof(code)>(base);
+    CRASH_UNLESS(first && *first == base + 2);
+    auto second = cs::findNthB<2, false, -1, sizeof(code)>(base);
+    CRASH_UNLESS(second && *second == base + 4);
+    CRASH_UNLESS(cs::readb(base) == base + 2);
+}
+
+// Searches with capstone, as findNthB did before decode::decode
+template<uint32_t n, size_t szBytes>
+static std::optional<uint32_t*> findNthBCapstone(uint32_t const* addr) {
+    return cs::findNth<n, -1, szBytes>(addr, &cs::bConv, [](cs_insn*) { return false; });
+}
+
+// The decoder must agree with capstone on every branch of a real il2cpp function,
+// and findNthB must find the same branches as the capstone search Init used to rely on
+static void testCapstoneEquivalence() {
+    il2cpp_functions::Init();
+    auto const* addr = reinterpret_cast<uint32_t const*>(il2cpp_functions::il2cpp_Class_FromIl2CppType);
+    CRASH_UNLESS(addr);
+
+    cs_insn* insn = cs_malloc(cs::getHandle());
+    for (std::size_t i = 0; i < 1024 / sizeof(uint32_t); i++) {
+        auto const* word = addr + i;
+        auto const* bytes = reinterpret_cast<uint8_t const*>(word);
+        std::size_t size = sizeof(uint32_t);
+        auto pc = reinterpret_cast<uint64_t>(word);
+        auto insnDecoded = decode(*word, pc);
+        if (!cs_disasm_iter(cs::getHandle(), &bytes, &size, &pc, insn)) {
+            CRASH_UNLESS(insnDecoded.kind == Kind::Other || insnDecoded.kind == Kind::Unknown);
+            continue;
+        }
+        switch (insn->id) {
+            case ARM64_INS_B:
+                CRASH_UNLESS(insnDecoded.kind == Kind::B || insnDecoded.kind == Kind::BCond);
+                CRASH_UNLESS(insnDecoded.imm == insn->detail->arm64.operands[0].imm);
+                break;
+            case ARM64_INS_BL:
+                CRASH_UNLESS(insnDecoded.kind == Kind::Bl);
+                CRASH_UNLESS(insnDecoded.imm == insn->detail->arm64.operands[0].imm);
+                break;
+            case ARM64_INS_BR:
+                CRASH_UNLESS(insnDecoded.kind == Kind::Br);
+                break;
+            case ARM64_INS_BLR:
+                CRASH_UNLESS(insnDecoded.kind == Kind::Blr);
+                break;
+            case ARM64_INS_RET:
+                CRASH_UNLESS(insnDecoded.kind == Kind::Ret);
+                break;
+            default:
+                CRASH_UNLESS(!cs::kindMatch<Kind::B, Kind::BCond, Kind::Bl, Kind::Br, Kind::Blr, Kind::Ret>(insnDecoded));
+        }
+    }
+    cs_free(insn, 1);
+
+    // The searches il2cpp_functions::Init runs on this function
+    CRASH_UNLESS((cs::findNthB<4, false>(addr)) == (findNthBCapstone<4, 4096>(addr)));
+    CRASH_UNLESS((cs::findNthB<6, false, -1, 1024>(addr)) == (findNthBCapstone<6, 1024>(addr)));
+}
+
+static void testDecodedCache() {
+    // bl #4; ret; bl #8; ret
+    std::array<uint32_t, 4> code{ 0x94000001, 0xD65F03C0, 0x94000002, 0xD65F03C0 };
+    auto* base = code.data();
+
+    auto first = cs::findNthBl<1, false, -1, sizeof(code)>(base);
+    CRASH_UNLESS(first && *first == base + 1);
+    // A search starting within the cached stream shares it
+    auto range = cs::decoded(base + 2, 2);
+    CRASH_UNLESS(range.offset == 2 && range[0].kind == cs::decode::Kind::Bl);
+
+    // Patching without invalidating would keep returning the old target
+    code[0] = 0x94000003;
+    HookTracker::CodePatched(base, sizeof(uint32_t));
+    first = cs::findNthBl<1, false, -1, sizeof(code)>(base);
+    CRASH_UNLESS(first && *first == base + 3);
+}
+
+static void testOverlappingStreams() {
+    std::array<uint32_t, 8> code;
+    code.fill(0xD503201F);
+    auto* base = code.data();
+
+    // [2, 6) then the overlapping [0, 4), which must not leave two streams covering 2 and 3
+    cs::decoded(base + 2, 4);
+    cs::decoded(base, 4);
+    // Patching within both must not leave the pre-patch instruction cached in either
+    code[3] = 0x94000001;
+    HookTracker::CodePatched(base + 3, sizeof(uint32_t));
+    CRASH_UNLESS(cs::decoded(base, 4)[3].kind == Kind::Bl);
+    CRASH_UNLESS(cs::decoded(base + 2, 4)[1].kind == Kind::Bl);
+}
+
+#endif
@@ -7,6 +7,7 @@
 #pragma clang diagnostic ignored "-Wunused-parameter"
 #include "../../shared/utils/hooking.hpp"
 #include "../../shared/utils/base-wrapper-type.hpp"
+#include <chrono>
 
 MAKE_HOOK(test, 0x0, void, int arg) {
     throw il2cpp_utils::RunMethodException("lol rekt", nullptr);
@@ -33,5 +34,44 @@ MAKE_HOOK_WRAPPER(test2_hook, &test2, bs_hook::Il2CppWrapperType, bs_hook::Il2Cp
     return ret;
     // Return from overall hook is converted to a void*
 }
+
+// Hooks with identical bodies, differing only in how exceptions crossing the hook are handled
+MAKE_HOOK_NO_CATCH(bench_no_catch, 0x0, int, int arg) {
+    return arg + 1;
+}
+
+MAKE_HOOK(bench_catch, 0x0, int, int arg) {
+    return arg + 1;
+}
+
+MAKE_HOOK_LANDING_PAD(bench_landing_pad, 0x0, int, int arg) {
+    return arg + 1;
+}
+
+MAKE_HOOK_LANDING_PAD_NO_TRANSLATE(bench_landing_pad_no_translate, 0x0, int, int arg) {
+    return arg + 1;
+}
+
+template<typename T>
+static void bench_hook_call(const char* label) {
+    constexpr int iterations = 10000000;
+    // Call through a volatile function pointer so the wrapper cannot be inlined into the loop
+    typename T::funcType volatile func = T::hook();
+    int acc = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        acc = func(acc);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    il2cpp_utils::Logger.info("{}: {} calls in {}ns ({:.3f}ns/call) result: {}", label, iterations, elapsed.count(), (double)elapsed.count() / iterations, acc);
+}
+
+// Compares the per-call overhead of the different hook exception barriers
+static void bench_hook_barriers() {
+    bench_hook_call<Hook_bench_no_catch>("MAKE_HOOK_NO_CATCH");
+    bench_hook_call<Hook_bench_catch>("MAKE_HOOK");
+    bench_hook_call<Hook_bench_landing_pad>("MAKE_HOOK_LANDING_PAD");
+    bench_hook_call<Hook_bench_landing_pad_no_translate>("MAKE_HOOK_LANDING_PAD_NO_TRANSLATE");
+}
 #pragma clang diagnostic pop
 #endif
@@ -0,0 +1,152 @@
+#ifdef TEST_INVOKER
+#include "../../shared/utils/il2cpp-utils.hpp"
+#include "../../shared/utils/typedefs-string.hpp"
+#include <chrono>
+
+static_assert(std::is_same_v<il2cpp_utils::invokers::DirectCallType<int>::type, int>);
+static_assert(std::is_same_v<il2cpp_utils::invokers::DirectCallType<StringW>::type, void*>);
+static_assert(std::is_same_v<il2cpp_utils::invokers::DirectCallType<ByRef<int>>::type, void*>);
+
+template<typename F>
+static void bench_invoke(const char* label, F&& invoke) {
+    constexpr int iterations = 100000;
+    int acc = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        acc = invoke(acc, i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    il2cpp_utils::Logger.info("{}: {} calls in {}ns ({:.3f}ns/call) result: {}", label, iterations, elapsed.count(), (double)elapsed.count() / iterations, acc);
+}
+
+// Compares runtime_invoke (boxed value type return) against calling the methodPointer directly
+static void bench_invokers() {
+    using namespace il2cpp_utils;
+    auto* maxMethod = CRASH_UNLESS(FindMethod("System", "Math", "Max", std::array<Il2CppType const*, 2>{ ExtractIndependentType<int>(), ExtractIndependentType<int>() }));
+
+    bench_invoke("RunMethod", [maxMethod](int a, int b) { return RunMethodRethrow<int, false>(nullptr, maxMethod, a, b); });
+    bench_invoke("RunMethodDirect", [maxMethod](int a, int b) { return RunMethodDirect<int, false>(nullptr, maxMethod, a, b).get_or_rethrow(); });
+    bench_invoke("RunMethod (checkTypes)", [maxMethod](int a, int b) { return RunMethodRethrow<int, true>(nullptr, maxMethod, a, b); });
+    bench_invoke("RunMethodDirect (checkTypes)", [maxMethod](int a, int b) { return RunMethodDirect<int, true>(nullptr, maxMethod, a, b).get_or_rethrow(); });
+    // Reference type arguments, whose checks are cached on the classes of the instances passed
+    auto* equalsMethod = CRASH_UNLESS(FindMethod("System", "String", "Equals", std::array<Il2CppType const*, 2>{ ExtractIndependentType<Il2CppString*>(), ExtractIndependentType<Il2CppString*>() }));
+    auto* str = newcsstr("test");
+    bench_invoke("RunMethodDirect (checkTypes, reference args)", [equalsMethod, str](int a, int) { return a + RunMethodDirect<bool, true>(nullptr, equalsMethod, str, str).get_or_rethrow(); });
+
+    // Static property getter, looked up by name each call against a resolved handle
+    static PropertyHandle<int> tickCount("System", "Environment", "TickCount");
+    CRASH_UNLESS(tickCount);
+    bench_invoke("GetPropertyValue", [](int a, int) { return a ^ *GetPropertyValue<int>("System", "Environment", "TickCount"); });
+    bench_invoke("PropertyHandle::Get", [](int a, int) { return a ^ tickCount.Get().get_or_rethrow(); });
+}
+
+static void test_direct_invoke() {
+    using namespace il2cpp_utils;
+    auto str = StringW("test");
+    // instance method on a reference type, with a wrapper type argument
+    auto* equals = CRASH_UNLESS(FindMethod(str, "Equals", std::array<Il2CppType const*, 1>{ ExtractIndependentType<StringW>() }));
+    CRASH_UNLESS(RunMethodDirect<bool>(str, equals, StringW("test")).get_or_rethrow());
+    // reference type return
+    auto* toUpper = CRASH_UNLESS(FindMethod(str, "ToUpper"));
+    auto upper = RunMethodDirect<StringW>(str, toUpper).get_or_rethrow();
+    CRASH_UNLESS(upper == "TEST");
+    // instance method on a value type, must not box
+    int value = 5;
+    auto* toString = CRASH_UNLESS(FindMethod(classof(int), "ToString"));
+    auto valueStr = RunMethodDirect<StringW>(value, toString).get_or_rethrow();
+    CRASH_UNLESS(valueStr == "5");
+    // void vs. non-void mismatches are rejected even without type checks
+    auto* memoryBarrier = CRASH_UNLESS(FindMethodUnsafe("System.Threading", "Thread", "MemoryBarrier", 0));
+    CRASH_UNLESS(RunMethodDirect<int, false>(nullptr, memoryBarrier).has_exception());
+    CRASH_UNLESS(RunMethodDirect<void, false>(str, toUpper).has_exception());
+}
+
+// Probing for missing members should cost a cache probe after the first miss, and must not be confused with found members
+static void test_lookup_misses() {
+    using namespace il2cpp_utils;
+    auto* klass = CRASH_UNLESS(GetClassFromName("System", "String"));
+    CRASH_UNLESS(!TryFindField(klass, "__missing__"));
+    CRASH_UNLESS(!TryFindProperty(klass, "__missing__"));
+    CRASH_UNLESS(!TryFindMethodUnsafe(klass, "__missing__", 0));
+    CRASH_UNLESS(!TryFindMethod(FindMethodInfo(klass, "__missing__", {}, {})));
+    CRASH_UNLESS(TryFindProperty(klass, "Length"));
+    CRASH_UNLESS(TryFindMethodUnsafe(klass, "ToUpper", 0));
+    // A silent miss must not be returned to a lookup which logs, a logged one serves both
+    CRASH_UNLESS(!lookup_entry<const MethodInfo*>::miss(false).valid(true));
+    CRASH_UNLESS(lookup_entry<const MethodInfo*>::miss(false).valid(false));
+    CRASH_UNLESS(lookup_entry<const MethodInfo*>::miss(true).valid(true));
+    CRASH_UNLESS(!FindMethodUnsafe(klass, "__missing__", 0));
+
+    bench_invoke("TryFindMethodUnsafe (cached miss)", [klass](int a, int) { return a + (TryFindMethodUnsafe(klass, "__missing__", 0) == nullptr); });
+    bench_invoke("FindMethodUnsafe (cached miss)", [klass](int a, int) { return a + (FindMethodUnsafe(klass, "__missing__", 0) == nullptr); });
+}
+
+// The member index of a class must include inherited members and interface methods resolved to their implementations
+static void test_member_index() {
+    using namespace il2cpp_utils;
+    auto* klass = CRASH_UNLESS(GetClassFromName("System.Collections.Generic", "List`1"));
+    auto* listOfInt = CRASH_UNLESS(MakeGeneric(klass, std::array<const Il2CppClass*, 1>{ classof(int) }));
+    auto const& index = GetMemberIndex(listOfInt);
+    CRASH_UNLESS(&index == &GetMemberIndex(listOfInt));
+    // declared on List`1
+    CRASH_UNLESS(!index.FindMethods("Add").empty());
+    CRASH_UNLESS(index.FindProperty("Count"));
+    // inherited from System.Object
+    CRASH_UNLESS(!index.FindMethods("GetHashCode").empty());
+    // interface methods are only indexed as List`1's callable implementations, never as the abstract interface methods
+    for (auto const& [name, methods] : index.interfaceMethods) {
+        for (auto const* method : methods) {
+            CRASH_UNLESS(method->methodPointer && !il2cpp_functions::class_is_interface(method->klass));
+        }
+    }
+    CRASH_UNLESS(FindMethodUnsafe(listOfInt, "Add", 1) == index.FindMethods("Add").front());
+}
+
+// Lookups through the member index must find what the linear searches they replaced did
+static void test_member_index_matches_linear() {
+    using namespace il2cpp_utils;
+    auto* list = CRASH_UNLESS(GetClassFromName("System.Collections.Generic", "List`1"));
+    auto* listOfInt = CRASH_UNLESS(MakeGeneric(list, std::array<const Il2CppClass*, 1>{ classof(int) }));
+    auto* memoryStream = CRASH_UNLESS(GetClassFromName("System.IO", "MemoryStream"));
+    for (auto* klass : { classof(Il2CppString*), listOfInt, memoryStream }) {
+        for (auto* current = klass; current; current = current->parent) {
+            for (auto const* method : std::span(current->methods, current->method_count)) {
+                // FindMethodUnsafe used to be class_get_method_from_name, which searches klass and then its parents
+                auto const* linear = il2cpp_functions::class_get_method_from_name(klass, method->name, method->parameters_count);
+                CRASH_UNLESS(FindMethodUnsafe(klass, method->name, method->parameters_count) == linear);
+                // FindMethod used to search klass and then its parents for a perfect match first
+                if (current == klass && !il2cpp_functions::method_is_generic(method)) {
+                    std::vector<const Il2CppType*> types;
+                    for (uint32_t i = 0; i < method->parameters_count; i++) {
+                        types.push_back(il2cpp_functions::method_get_param(method, i));
+                    }
+                    CRASH_UNLESS(FindMethod(FindMethodInfo(klass, method->name, {}, types)) == method);
+                }
+            }
+        }
+    }
+}
+
+// Every compiled instantiation of a generic definition is found, and MakeGeneric returns the compiled class for them
+static void test_generic_instantiations() {
+    using namespace il2cpp_utils;
+    auto* klass = CRASH_UNLESS(GetClassFromName("System.Collections.Generic", "List`1"));
+    auto instantiations = GetGenericInstantiations(klass);
+    CRASH_UNLESS(!instantiations.empty());
+    for (auto* genClass : instantiations) {
+        CRASH_UNLESS(il2cpp_type_check::GetGenericTemplateClass(genClass) == klass);
+    }
+    CRASH_UNLESS(GetGenericInstantiations(klass).size() == instantiations.size());
+    CRASH_UNLESS(GetGenericInstantiations(classof(int)).empty());
+}
+
+// classof is served from its table slot once the slots are resolved, and agrees with the lookup it caches
+static void test_classof_slots() {
+    using namespace il2cpp_utils;
+    ResolveClassofSlots();
+    CRASH_UNLESS(il2cpp_type_check::classof_slot<int>::klass.load() == il2cpp_functions::defaults->int32_class);
+    CRASH_UNLESS(classof(int) == il2cpp_type_check::il2cpp_no_arg_class<int>::get());
+    CRASH_UNLESS(classof(Il2CppString*) == il2cpp_functions::defaults->string_class);
+    bench_invoke("classof", [](int a, int) { return a ^ static_cast<int>(reinterpret_cast<uintptr_t>(classof(Il2CppObject*))); });
+}
+#endif
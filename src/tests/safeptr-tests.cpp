@@ -1,6 +1,8 @@
 #ifdef TEST_SAFEPTR
 #include "../../shared/utils/typedefs.h"
 #include <cassert>
+#include <chrono>
+#include <cstring>
 
 static void testRef(SafePtr<int>& ref) {
     *ref = 55;
@@ -60,7 +62,125 @@ static void test() {
     // Instead, consider using -> explicitly, or passing SafePtr<T> instances either by reference (strongly suggested) or by value/move.
 }
 
+static void test_slab() {
+    auto before = gc_slab_get_stats();
+    int x = 3;
+    {
+        // Each SafePtr takes one wrapper from the slab and returns it on destruction
+        SafePtr<int> a(&x);
+        SafePtr<int> b(&x);
+        auto during = gc_slab_get_stats();
+        assert(during.allocations - before.allocations == 2);
+    }
+    auto after = gc_slab_get_stats();
+    assert(after.frees - before.frees == 2);
+    // Freed slots are reused by the same thread without taking a lock
+    {
+        SafePtr<int> a(&x);
+        assert(gc_slab_get_stats().thread_cache_hits > after.thread_cache_hits);
+    }
+    {
+        std::vector<int, gc_allocator<int>> vec{ 1, 2, 3 };
+        assert(vec[2] == 3);
+    }
+}
+
 #include "../../shared/utils/il2cpp-utils.hpp"
+static void test_realloc() {
+    auto* p = static_cast<uint8_t*>(gc_alloc_specific(20));
+    std::memset(p, 0xAB, 20);
+    assert(gc_size_specific(p) == 20);
+    // Fits in the rounded up block, so stays in place with the new bytes zeroed
+    auto* q = static_cast<uint8_t*>(gc_realloc_specific(p, 30));
+    assert(q == p && q[19] == 0xAB && q[20] == 0 && q[29] == 0);
+    // Shrinking stays in place, growing again must not resurrect the old bytes
+    q = static_cast<uint8_t*>(gc_realloc_specific(q, 4));
+    q = static_cast<uint8_t*>(gc_realloc_specific(q, 20));
+    assert(q == p && q[3] == 0xAB && q[4] == 0);
+    // Moving copies only the old size
+    auto* r = static_cast<uint8_t*>(gc_realloc_specific(q, 4096));
+    assert(r[3] == 0xAB && r[4] == 0 && r[4095] == 0 && gc_size_specific(r) == 4096);
+    // Moving reserved half the new size again, so growing into it stays in place
+    auto* u = static_cast<uint8_t*>(gc_realloc_specific(r, 6000));
+    assert(u == r && u[4096] == 0 && u[5999] == 0 && gc_size_specific(u) == 6000);
+    gc_free_specific(u);
+
+    // Blocks not from gc_alloc_specific have no recorded size, but can still be resized and freed
+    if (il2cpp_functions::hasGCFuncs) {
+        auto* f = static_cast<uint8_t*>(il2cpp_functions::GarbageCollector_AllocateFixed(64, nullptr));
+        std::memset(f, 0xEF, 64);
+        assert(gc_size_specific(f) == 0);
+        auto* g = static_cast<uint8_t*>(gc_realloc_specific(f, 64));
+        assert(g[63] == 0xEF && gc_size_specific(g) == 64);
+        gc_free_specific(g);
+    }
+
+    // Slab allocations stay in place within a size class and copy min(old, new) otherwise
+    auto* s = static_cast<uint8_t*>(gc_slab_alloc(40));
+    std::memset(s, 0xCD, 40);
+    auto* t = static_cast<uint8_t*>(gc_slab_realloc(s, 40, 48));
+    assert(t == s && t[39] == 0xCD && t[40] == 0);
+    t = static_cast<uint8_t*>(gc_slab_realloc(t, 48, 1024));
+    assert(t[39] == 0xCD && t[40] == 0 && gc_size_specific(t) == 1024);
+    gc_slab_free(t, 1024);
+}
+
+template<typename F>
+static void bench_growth(const char* label, F&& grow) {
+    constexpr int iterations = 1000;
+    auto start = std::chrono::steady_clock::now();
+    size_t acc = 0;
+    for (int i = 0; i < iterations; i++) {
+        acc += grow();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    il2cpp_utils::Logger.info("{}: {} runs in {}ns ({:.3f}ns/run) result: {}", label, iterations, elapsed.count(), (double)elapsed.count() / iterations, acc);
+}
+
+// Grows a buffer of 1024 ints through each of the resize paths
+static void bench_realloc() {
+    constexpr size_t count = 1024;
+    bench_growth("vector<int, gc_allocator>", [] {
+        std::vector<int, gc_allocator<int>> vec;
+        for (size_t i = 0; i < count; i++) vec.push_back(i);
+        return vec.size();
+    });
+    bench_growth("gc_realloc_specific", [] {
+        size_t capacity = 1;
+        auto* data = static_cast<int*>(gc_alloc_specific(capacity * sizeof(int)));
+        for (size_t i = 0; i < count; i++) {
+            if (i == capacity) data = static_cast<int*>(gc_realloc_specific(data, (capacity *= 2) * sizeof(int)));
+            data[i] = i;
+        }
+        gc_free_specific(data);
+        return capacity;
+    });
+    // Growing by small steps, which the room reserved by moving reallocs serves in place
+    bench_growth("gc_realloc_specific (16 ints at a time)", [] {
+        size_t capacity = 16;
+        auto* data = static_cast<int*>(gc_alloc_specific(capacity * sizeof(int)));
+        for (size_t i = 0; i < count; i++) {
+            if (i == capacity) data = static_cast<int*>(gc_realloc_specific(data, (capacity += 16) * sizeof(int)));
+            data[i] = i;
+        }
+        gc_free_specific(data);
+        return capacity;
+    });
+    bench_growth("gc_slab_realloc", [] {
+        size_t capacity = 1;
+        auto* data = static_cast<int*>(gc_slab_alloc(capacity * sizeof(int)));
+        for (size_t i = 0; i < count; i++) {
+            if (i == capacity) {
+                data = static_cast<int*>(gc_slab_realloc(data, capacity * sizeof(int), capacity * 2 * sizeof(int)));
+                capacity *= 2;
+            }
+            data[i] = i;
+        }
+        gc_slab_free(data, capacity * sizeof(int));
+        return capacity;
+    });
+}
+
 static void test_cast() {
     int x = 3;
     {
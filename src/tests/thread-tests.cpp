@@ -1,5 +1,8 @@
 #ifdef TEST_THREAD
 #include "utils/il2cpp-utils.hpp"
+#include "config/config-utils.hpp"
+#include <filesystem>
+#include <fstream>
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wunused-variable"
@@ -141,6 +144,62 @@ void test_async() {
     IL2CPP_ASYNC_TEST(&func4, 1);
     IL2CPP_ASYNC_TEST([&v](int b){ return v = b; }, 1);
 }
+
+// creating instances of the same class from many threads runs its cctor once, and every thread sees it finished
+void test_parallel_create() {
+    auto* klass = CRASH_UNLESS(il2cpp_utils::GetClassFromName("System", "Random"));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; i++) {
+        threads.emplace_back([klass]() {
+            for (int j = 0; j < 100; j++) {
+                auto* obj = CRASH_UNLESS(il2cpp_utils::createManual(klass));
+                CRASH_UNLESS(klass->cctor_finished_or_no_cctor || !klass->has_cctor);
+                gc_free_specific(obj);
+                CRASH_UNLESS(il2cpp_utils::AllocateSized(64 + j));
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+}
+
+static il2cpp_utils::WarmUpRegistration warmUpInt("System::Int32", []() { return classof(int) != nullptr; });
+
+// registered lookups are resolved once, in parallel, and failed ones are retried by the next WarmUp
+void test_warmup() {
+    il2cpp_utils::RegisterWarmUpClass("System", "Random");
+    il2cpp_utils::RegisterWarmUpMethod("System", "Math", "Max", 2);
+    il2cpp_utils::RegisterWarmUpMethod("System", "Math", "__missing__", 0);
+    std::atomic_size_t progressCalls = 0;
+    auto stats = il2cpp_utils::WarmUp(4, [&progressCalls](std::size_t done, std::size_t total) { CRASH_UNLESS(done <= total); progressCalls++; });
+    CRASH_UNLESS(stats.failed >= 1);
+    CRASH_UNLESS(progressCalls == stats.resolved + stats.failed);
+    auto again = il2cpp_utils::WarmUp();
+    CRASH_UNLESS(again.resolved == 0 && again.failed == stats.failed);
+}
+
+// dumping in parallel writes every matching class exactly once, as one line each
+void test_dump_classes() {
+    il2cpp_utils::ClassDumpOptions options;
+    options.namespacePrefix = "System.Collections";
+    options.assemblies = { "mscorlib" };
+    options.threads = 4;
+    options.bufferSize = 4096;
+    std::atomic_size_t filtered = 0;
+    options.filter = [&filtered](Il2CppClass* klass) { filtered++; return true; };
+    // There is no /tmp on Android, so write next to the xref cache
+    auto dir = getDataDir(MOD_ID);
+    if (!direxists(dir)) mkpath(dir);
+    auto path = dir + "dump-test.jsonl";
+    auto stats = CRASH_UNLESS(il2cpp_utils::DumpClasses(path, options));
+    CRASH_UNLESS(stats.classes > 0 && stats.classes == filtered);
+    std::ifstream file(path);
+    std::size_t lines = 0;
+    for (std::string line; std::getline(file, line); lines++) {
+        CRASH_UNLESS(line.starts_with("{\"assembly\":\"mscorlib\""));
+    }
+    CRASH_UNLESS(lines == stats.classes);
+    std::filesystem::remove(path);
+}
 #pragma clang diagnostic pop
 
 #endif
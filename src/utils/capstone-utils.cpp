@@ -1,5 +1,8 @@
 #include "../../shared/utils/capstone-utils.hpp"
 #include <android/log.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
 
 csh handle;
 bool valid = false;
@@ -28,23 +31,66 @@ csh getHandle() {
     return handle;
 }
 
+// Decoded instruction streams, keyed by the first decoded address. Streams are immutable once published, extending one replaces it.
+// Streams never overlap, so the only stream that may contain an address is the last one starting at or before it.
+static std::map<const uint32_t*, std::shared_ptr<const std::vector<decode::Insn>>> decodedStreams;
+static std::mutex decodedStreamsMutex;
+
+static void decodeInto(std::vector<decode::Insn>& out, const uint32_t* addr, std::size_t count) {
+    out.reserve(out.size() + count);
+    for (std::size_t i = 0; i < count; i++) {
+        out.push_back(decode::decode(addr[i], reinterpret_cast<uint64_t>(addr + i)));
+    }
+}
+
+DecodedRange decoded(const uint32_t* addr, std::size_t count) {
+    std::lock_guard lock(decodedStreamsMutex);
+    auto itr = decodedStreams.upper_bound(addr);
+    auto const* start = addr;
+    std::shared_ptr<const std::vector<decode::Insn>> base;
+    if (itr != decodedStreams.begin()) {
+        auto prev = std::prev(itr);
+        if (static_cast<std::size_t>(addr - prev->first) < prev->second->size()) {
+            start = prev->first;
+            base = prev->second;
+        }
+    }
+    std::size_t offset = addr - start;
+    if (base && offset + count <= base->size()) {
+        return { std::move(base), offset, count };
+    }
+
+    // Merge the streams overlapping the new one into it
+    auto const* last = addr + count;
+    while (itr != decodedStreams.end() && itr->first < last) {
+        last = std::max(last, itr->first + itr->second->size());
+        itr = decodedStreams.erase(itr);
+    }
+    auto stream = base ? std::make_shared<std::vector<decode::Insn>>(*base) : std::make_shared<std::vector<decode::Insn>>();
+    decodeInto(*stream, start + stream->size(), (last - start) - stream->size());
+    decodedStreams.insert_or_assign(start, stream);
+    return { std::move(stream), offset, count };
+}
+
+void invalidateDecoded(const void* addr, std::size_t size) {
+    auto const* begin = reinterpret_cast<const uint32_t*>(addr);
+    auto const* end = reinterpret_cast<const uint32_t*>(reinterpret_cast<uintptr_t>(addr) + size);
+    std::lock_guard lock(decodedStreamsMutex);
+    auto itr = decodedStreams.upper_bound(begin);
+    if (itr != decodedStreams.begin()) {
+        auto prev = std::prev(itr);
+        if (prev->first + prev->second->size() > begin) decodedStreams.erase(prev);
+    }
+    while (itr != decodedStreams.end() && itr->first < end) {
+        itr = decodedStreams.erase(itr);
+    }
+}
+
 uint32_t* readb(const uint32_t* addr) {
-    cs_insn* insns;
-    // Read from addr, 1 instruction, with pc at addr, into insns.
-    // TODO: consider using cs_disasm_iter
-    auto count = cs_disasm(handle, reinterpret_cast<const uint8_t*>(addr), sizeof(uint32_t), reinterpret_cast<uint64_t>(addr), 1, &insns);
-    CRASH_UNLESS(count == 1);
-    auto inst = insns[0];
+    auto insn = decode::decode(*addr, reinterpret_cast<uint64_t>(addr));
     // Thunks have a single b
-    CRASH_UNLESS(inst.id == ARM64_INS_B);
-    auto platinsn = inst.detail->arm64;
-    CRASH_UNLESS(platinsn.op_count == 1);
-    auto op = platinsn.operands[0];
-    CRASH_UNLESS(op.type == ARM64_OP_IMM);
-    // Our b dest is addr + (imm << 2), except capstone does this for us.
-    auto dst = reinterpret_cast<uint32_t*>(op.imm);
-    cs_free(insns, 1);
-    return dst;
+    CRASH_UNLESS(insn.kind == decode::Kind::B || insn.kind == decode::Kind::BCond);
+    return reinterpret_cast<uint32_t*>(insn.imm);
 }
 
 std::optional<uint32_t*> blConv(cs_insn* insn) {
@@ -76,6 +122,42 @@ std::optional<std::tuple<uint32_t*, arm64_reg, uint32_t*>> pcRelConv(cs_insn* in
     }
 }
 
+std::optional<std::tuple<uint32_t*, arm64_reg, uint32_t*>> pcRelConv(decode::Insn const& insn, uint32_t const* addr) {
+    using tup = std::tuple<uint32_t*, arm64_reg, uint32_t*>;
+    switch (insn.kind) {
+        case decode::Kind::Adr:
+        case decode::Kind::Adrp:
+            return tup{ const_cast<uint32_t*>(addr), insn.rd, reinterpret_cast<uint32_t*>(insn.imm) };
+        default:
+            return std::nullopt;
+    }
+}
+
+std::optional<std::tuple<uint32_t*, arm64_reg, int64_t>> regMatchConv(decode::Insn const& match, uint32_t const* addr, arm64_reg toMatch) {
+    using tup = std::tuple<uint32_t*, arm64_reg, int64_t>;
+    switch (match.kind) {
+        case decode::Kind::AddImm:
+        case decode::Kind::LdrImm:
+            if (match.rn != toMatch) return std::nullopt;
+            return tup{ const_cast<uint32_t*>(addr), match.rd, match.imm };
+        case decode::Kind::Unknown: {
+            // Rarer ADD/LDR forms, fall back to capstone for this word
+            cs_insn* insn = cs_malloc(handle);
+            auto code = reinterpret_cast<const uint8_t*>(addr);
+            size_t size = sizeof(uint32_t);
+            auto ptr = reinterpret_cast<uint64_t>(addr);
+            std::optional<tup> result;
+            if (cs_disasm_iter(handle, &code, &size, &ptr, insn)) {
+                result = regMatchConv(insn, toMatch);
+            }
+            cs_free(insn, 1);
+            return result;
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
 std::optional<std::tuple<uint32_t*, arm64_reg, int64_t>> regMatchConv(cs_insn* match, arm64_reg toMatch) {
     // We need 1 to 2 operands, match 1 to 2 to register, determine dst reg from incoming instruction
     // For now, it's pretty common for add immediates, which have dst as first op, src 2nd, imm third
@@ -4,34 +4,357 @@
 #include "shared/utils/utils.h"
 
 #include <android/log.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
 
-[[nodiscard]] void* gc_alloc_specific(size_t sz) {
-    // This function assumes il2cpp_functions will be called at a reasonable time, instead will warn you on allocating unsafe memory.
-    if (il2cpp_functions::hasGCFuncs) {
-        // We should absolutely panic if we thought we had the allocation function, but it gave us null.
-        auto* ptr = CRASH_UNLESS(il2cpp_functions::GarbageCollector_AllocateFixed(sz, nullptr));
-        return ptr;
-    } else {
-        auto* ptr = calloc(1, sz);
-        // We cannot use our logger because we allocate it using this function.
-        __android_log_print(ANDROID_LOG_WARN, "QuestHook[GC_Alloc]", "Allocation at: %p for size: %lu fallback to calloc!", ptr, sz);
-        return ptr;
+namespace {
+    // Precedes every gc_alloc_specific block, so frees and reallocs know what they are dealing with without a lookup.
+    // 16 bytes, so the returned pointers keep the GC's 16 byte alignment.
+    struct BlockHeader {
+        // Size requested by the caller
+        size_t size;
+        // Usable size of the block in 16 byte granules, bytes past size are kept zeroed
+        uint32_t granules;
+        // Tells blocks from gc_alloc_specific apart from foreign pointers, and whether the block fell back to calloc
+        uint32_t tag;
+    };
+    static_assert(sizeof(BlockHeader) == 16);
+
+    constexpr uint32_t GC_BLOCK_TAG = 0x6B6C4247;      // 'GBlk'
+    constexpr uint32_t CALLOC_BLOCK_TAG = 0x6B6C4243;  // 'CBlk'
+
+    BlockHeader* headerOf(void* ptr) {
+        return static_cast<BlockHeader*>(ptr) - 1;
+    }
+
+    // Best effort, a pointer that is not from gc_alloc_specific is very unlikely to be preceded by one of the tags
+    bool isBlock(BlockHeader const* header) {
+        return header->tag == GC_BLOCK_TAG || header->tag == CALLOC_BLOCK_TAG;
     }
+
+    void* allocBlock(size_t sz, size_t capacity) {
+        void* ptr;
+        uint32_t tag;
+        // This function assumes il2cpp_functions will be called at a reasonable time, instead will warn you on allocating unsafe memory.
+        if (il2cpp_functions::hasGCFuncs) {
+            // We should absolutely panic if we thought we had the allocation function, but it gave us null.
+            ptr = CRASH_UNLESS(il2cpp_functions::GarbageCollector_AllocateFixed(sizeof(BlockHeader) + capacity, nullptr));
+            tag = GC_BLOCK_TAG;
+        } else {
+            ptr = calloc(1, sizeof(BlockHeader) + capacity);
+            // We cannot use our logger because we allocate it using this function.
+            __android_log_print(ANDROID_LOG_WARN, "QuestHook[GC_Alloc]", "Allocation at: %p for size: %lu fallback to calloc!", ptr, sz);
+            if (!ptr) return nullptr;
+            tag = CALLOC_BLOCK_TAG;
+        }
+        auto* header = static_cast<BlockHeader*>(ptr);
+        *header = { sz, static_cast<uint32_t>(capacity / 16), tag };
+        return header + 1;
+    }
+
+    // Rounds up to the GC's 16 byte granule, the rounding is free to grow into
+    constexpr size_t roundCapacity(size_t sz) {
+        return (sz + 15) & ~size_t(15);
+    }
+
+    // Frees a pointer which is not from gc_alloc_specific the way it would be allocated now
+    void freeForeign(void* ptr) {
+        if (il2cpp_functions::hasGCFuncs) {
+            il2cpp_functions::GC_free(ptr);
+        } else {
+            free(ptr);
+        }
+    }
+}  // namespace
+
+[[nodiscard]] void* gc_alloc_specific(size_t sz) {
+    return allocBlock(sz, roundCapacity(sz));
 }
 
-[[nodiscard]] void* gc_realloc_specific(void* ptr,size_t new_size) {
-    auto* nPtr = gc_alloc_specific(new_size);
-    memcpy(nPtr, ptr, new_size);
+[[nodiscard]] void* gc_realloc_specific(void* ptr, size_t new_size) {
+    if (!ptr) return gc_alloc_specific(new_size);
+    auto* header = headerOf(ptr);
+    if (!isBlock(header)) {
+        // Not from gc_alloc_specific, so its size is unknown: copy as much as the new size, as this always did for such pointers
+        __android_log_print(ANDROID_LOG_WARN, "QuestHook[GC_Alloc]", "Reallocation of a block not from gc_alloc_specific: %p!", ptr);
+        auto* nPtr = gc_alloc_specific(new_size);
+        if (!nPtr) return nullptr;
+        std::memcpy(nPtr, ptr, new_size);
+        freeForeign(ptr);
+        return nPtr;
+    }
+    if (new_size <= size_t(header->granules) * 16) {
+        // Resize in place, clearing anything that is no longer part of the allocation
+        if (new_size < header->size) {
+            std::memset(static_cast<std::byte*>(ptr) + new_size, 0, header->size - new_size);
+        }
+        header->size = new_size;
+        return ptr;
+    }
+    // A block that grew is likely to grow again, so reserve half as much again for it to grow into in place
+    auto* nPtr = allocBlock(new_size, roundCapacity(new_size + new_size / 2));
+    if (!nPtr) return nullptr;
+    std::memcpy(nPtr, ptr, header->size);
     gc_free_specific(ptr);
     return nPtr;
 }
 
+size_t gc_size_specific(void* ptr) noexcept {
+    if (!ptr) return 0;
+    auto* header = headerOf(ptr);
+    return isBlock(header) ? header->size : 0;
+}
+
 void gc_free_specific(void* ptr) noexcept {
-    if (il2cpp_functions::hasGCFuncs) {
-        il2cpp_functions::GC_free(ptr);
+    if (!ptr) return;
+    auto* header = headerOf(ptr);
+    if (!isBlock(header)) {
+        freeForeign(ptr);
+        return;
+    }
+    auto const tag = header->tag;
+    // Clear the tag, so a double free or a stale pointer is not taken for a block
+    header->tag = 0;
+    if (tag == CALLOC_BLOCK_TAG) {
+        free(header);
+    } else {
+        il2cpp_functions::GC_free(header);
+    }
+}
+
+namespace {
+    // Slot sizes, every class larger than 8 is a multiple of 16 to keep slots 16 byte aligned
+    constexpr std::array<size_t, 9> sizeClasses{ 8, 16, 32, 48, 64, 96, 128, 192, 256 };
+    static_assert(sizeClasses.back() == GC_SLAB_MAX_SIZE);
+
+    // Size of each chunk requested from gc_alloc_specific, carved into slots of a single size class
+    constexpr size_t CHUNK_SIZE = 16 * 1024;
+    // Slots moved between a thread cache and its size class at once
+    constexpr uint32_t BATCH_SIZE = 16;
+    // Slots a thread may cache per size class before returning a batch
+    constexpr uint32_t THREAD_CACHE_SIZE = 2 * BATCH_SIZE;
+
+    // Maps (sz + 7) / 8 to the index of the smallest size class that fits sz
+    constexpr auto classLookup = []() {
+        std::array<uint8_t, GC_SLAB_MAX_SIZE / 8 + 1> lookup{};
+        uint8_t idx = 0;
+        for (size_t i = 0; i < lookup.size(); i++) {
+            while (sizeClasses[idx] < i * 8) idx++;
+            lookup[i] = idx;
+        }
+        return lookup;
+    }();
+
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    struct SizeClass {
+        std::mutex mutex;
+        FreeSlot* freelist = nullptr;
+        // Remainder of the most recent chunk that has not been handed out yet
+        std::byte* carve = nullptr;
+        std::byte* carveEnd = nullptr;
+    };
+
+    std::array<SizeClass, sizeClasses.size()> classes;
+
+    // Slots handed out before the GC functions are found come from calloc chunks, which the GC does not scan.
+    // They are kept apart from the GC backed classes and are only handed out until the GC functions are found,
+    // so a slot allocated later (ex: for a SafePtr) is always scanned.
+    constexpr size_t MAX_FALLBACK_CHUNKS = 32;
+    struct FallbackSlab {
+        std::mutex mutex;
+        std::array<FreeSlot*, sizeClasses.size()> freelists{};
+        std::array<std::byte*, sizeClasses.size()> carve{};
+        std::array<std::byte*, sizeClasses.size()> carveEnd{};
+        // Only appended to, each chunk is written before the count that publishes it
+        std::array<std::byte*, MAX_FALLBACK_CHUNKS> chunks{};
+        std::atomic<size_t> chunkCount;
+    };
+    FallbackSlab fallback;
+
+    std::atomic<size_t> allocations;
+    std::atomic<size_t> frees;
+    std::atomic<size_t> threadCacheHits;
+    std::atomic<size_t> chunks;
+    std::atomic<size_t> largeAllocations;
+
+    /// @brief Moves up to count slots from the size class into head, returns how many were moved.
+    uint32_t takeBatch(size_t idx, FreeSlot*& head, uint32_t count) {
+        auto& sizeClass = classes[idx];
+        auto const slotSize = sizeClasses[idx];
+        std::lock_guard lock(sizeClass.mutex);
+        uint32_t taken = 0;
+        for (; taken < count && sizeClass.freelist; taken++) {
+            auto* slot = sizeClass.freelist;
+            sizeClass.freelist = slot->next;
+            slot->next = head;
+            head = slot;
+        }
+        for (; taken < count; taken++) {
+            if (sizeClass.carve + slotSize > sizeClass.carveEnd) {
+                // Chunks are zeroed and scanned for references like any other gc_alloc_specific allocation.
+                // Only called once the GC functions are found, so they never fall back to calloc.
+                auto* chunk = static_cast<std::byte*>(gc_alloc_specific(CHUNK_SIZE));
+                if (!chunk) break;
+                chunks.fetch_add(1, std::memory_order_relaxed);
+                sizeClass.carve = chunk;
+                sizeClass.carveEnd = chunk + CHUNK_SIZE;
+            }
+            auto* slot = reinterpret_cast<FreeSlot*>(sizeClass.carve);
+            sizeClass.carve += slotSize;
+            slot->next = head;
+            head = slot;
+        }
+        return taken;
+    }
+
+    /// @brief Moves count slots from head back to the size class.
+    void returnBatch(size_t idx, FreeSlot*& head, uint32_t count) {
+        auto& sizeClass = classes[idx];
+        std::lock_guard lock(sizeClass.mutex);
+        for (uint32_t i = 0; i < count && head; i++) {
+            auto* slot = head;
+            head = slot->next;
+            slot->next = sizeClass.freelist;
+            sizeClass.freelist = slot;
+        }
+    }
+
+    bool isFallbackSlot(void const* ptr) noexcept {
+        auto const count = fallback.chunkCount.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; i++) {
+            auto* chunk = fallback.chunks[i];
+            if (ptr >= chunk && ptr < chunk + CHUNK_SIZE) return true;
+        }
+        return false;
+    }
+
+    /// @brief Allocates a slot from the calloc backed classes, for allocations made before the GC functions are found.
+    void* fallbackAlloc(size_t idx) {
+        auto const slotSize = sizeClasses[idx];
+        std::lock_guard lock(fallback.mutex);
+        if (auto* slot = fallback.freelists[idx]) {
+            fallback.freelists[idx] = slot->next;
+            slot->next = nullptr;
+            return slot;
+        }
+        if (fallback.carve[idx] + slotSize > fallback.carveEnd[idx]) {
+            auto const count = fallback.chunkCount.load(std::memory_order_relaxed);
+            if (count == MAX_FALLBACK_CHUNKS) return nullptr;
+            auto* chunk = static_cast<std::byte*>(calloc(1, CHUNK_SIZE));
+            // We cannot use our logger because we allocate it using this function.
+            __android_log_print(ANDROID_LOG_WARN, "QuestHook[GC_Alloc]", "Slab chunk at: %p for size class: %lu fallback to calloc!", chunk, slotSize);
+            if (!chunk) return nullptr;
+            fallback.chunks[count] = chunk;
+            fallback.chunkCount.store(count + 1, std::memory_order_release);
+            fallback.carve[idx] = chunk;
+            fallback.carveEnd[idx] = chunk + CHUNK_SIZE;
+        }
+        auto* slot = fallback.carve[idx];
+        fallback.carve[idx] += slotSize;
+        return slot;
+    }
+
+    struct ThreadCache {
+        std::array<FreeSlot*, sizeClasses.size()> heads{};
+        std::array<uint32_t, sizeClasses.size()> counts{};
+
+        ~ThreadCache() {
+            for (size_t idx = 0; idx < sizeClasses.size(); idx++) {
+                returnBatch(idx, heads[idx], counts[idx]);
+            }
+        }
+    };
+
+    thread_local ThreadCache threadCache;
+}  // namespace
+
+[[nodiscard]] void* gc_slab_alloc(size_t sz) {
+    if (sz > GC_SLAB_MAX_SIZE) {
+        largeAllocations.fetch_add(1, std::memory_order_relaxed);
+        return gc_alloc_specific(sz);
     }
-    // TODO: Also check if a GC free would have been valid?
-    else {
-        free(ptr);
+    auto const idx = classLookup[(sz + 7) / 8];
+    auto& cache = threadCache;
+    if (cache.counts[idx] > 0) {
+        threadCacheHits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        // The GC backed classes only ever hold memory the GC scans
+        if (!il2cpp_functions::hasGCFuncs) {
+            auto* slot = fallbackAlloc(idx);
+            if (slot) allocations.fetch_add(1, std::memory_order_relaxed);
+            return slot;
+        }
+        cache.counts[idx] = takeBatch(idx, cache.heads[idx], BATCH_SIZE);
+        if (cache.counts[idx] == 0) return nullptr;
+    }
+    auto* slot = cache.heads[idx];
+    cache.heads[idx] = slot->next;
+    cache.counts[idx]--;
+    // Slots are cleared on free, so only the link needs clearing
+    slot->next = nullptr;
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+void gc_slab_free(void* ptr, size_t sz) noexcept {
+    if (!ptr) return;
+    if (sz > GC_SLAB_MAX_SIZE) {
+        gc_free_specific(ptr);
+        return;
     }
-}
\ No newline at end of file
+    auto const idx = classLookup[(sz + 7) / 8];
+    // Clear the slot so stale references do not keep objects alive, it is still scanned by the GC
+    std::memset(ptr, 0, sizeClasses[idx]);
+    frees.fetch_add(1, std::memory_order_relaxed);
+    if (isFallbackSlot(ptr)) {
+        // Never mixed with GC backed slots, only reused while the GC functions are still missing
+        std::lock_guard lock(fallback.mutex);
+        auto* slot = static_cast<FreeSlot*>(ptr);
+        slot->next = fallback.freelists[idx];
+        fallback.freelists[idx] = slot;
+        return;
+    }
+    auto& cache = threadCache;
+    auto* slot = static_cast<FreeSlot*>(ptr);
+    slot->next = cache.heads[idx];
+    cache.heads[idx] = slot;
+    if (++cache.counts[idx] > THREAD_CACHE_SIZE) {
+        returnBatch(idx, cache.heads[idx], BATCH_SIZE);
+        cache.counts[idx] -= BATCH_SIZE;
+    }
+}
+
+[[nodiscard]] void* gc_slab_realloc(void* ptr, size_t old_size, size_t new_size) {
+    if (!ptr) return gc_slab_alloc(new_size);
+    if (old_size > GC_SLAB_MAX_SIZE && new_size > GC_SLAB_MAX_SIZE) {
+        return gc_realloc_specific(ptr, new_size);
+    }
+    if (old_size <= GC_SLAB_MAX_SIZE && new_size <= GC_SLAB_MAX_SIZE && classLookup[(old_size + 7) / 8] == classLookup[(new_size + 7) / 8]) {
+        // Same slot, only clear what is no longer part of the allocation
+        if (new_size < old_size) {
+            std::memset(static_cast<std::byte*>(ptr) + new_size, 0, old_size - new_size);
+        }
+        return ptr;
+    }
+    auto* nPtr = gc_slab_alloc(new_size);
+    if (!nPtr) return nullptr;
+    std::memcpy(nPtr, ptr, std::min(old_size, new_size));
+    gc_slab_free(ptr, old_size);
+    return nPtr;
+}
+
+gc_slab_stats gc_slab_get_stats() noexcept {
+    return {
+        .allocations = allocations.load(std::memory_order_relaxed),
+        .frees = frees.load(std::memory_order_relaxed),
+        .thread_cache_hits = threadCacheHits.load(std::memory_order_relaxed),
+        .chunks = chunks.load(std::memory_order_relaxed),
+        .large_allocations = largeAllocations.load(std::memory_order_relaxed),
+    };
+}
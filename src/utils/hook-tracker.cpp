@@ -5,7 +5,13 @@
 
 std::unordered_map<const void*, std::list<HookInfo>> HookTracker::hooks;
 
+void HookTracker::CodePatched(const void* const location, std::size_t size) noexcept {
+    cs::invalidateDecoded(location, size);
+}
+
 void HookTracker::AddHook(HookInfo info) noexcept {
+    // The hook patches the start of the destination
+    CodePatched(info.destination, sizeof(info.original_data));
     auto itr = hooks.find(info.destination);
     if (itr == hooks.end()) {
         hooks.emplace(info.destination, std::list<HookInfo>()).first->second.emplace_back(info);
@@ -102,6 +108,7 @@ void HookTracker::CombineHooks() noexcept {
                 // For each void*, find our match
                 auto match = hooks.find(itr.first);
                 if (match == hooks.end()) {
+                    CodePatched(itr.first, sizeof(HookInfo::original_data));
                     hooks.insert({ itr.first, itr.second });
                 } else {
                     // Add only unique items
@@ -128,15 +135,18 @@ extern "C" const void* __HOOKTRACKER_GET_HOOKS() {
     return reinterpret_cast<const void*>(HookTracker::GetHooks());
 }
 
-std::optional<uint32_t*> getHookBr(cs_insn* ins) {
-    return (ins->id == ARM64_INS_BR && ins->detail->arm64.operands[0].reg == ARM64_REG_X17) ? std::optional<uint32_t*>(reinterpret_cast<uint32_t*>(ins->address)) : std::nullopt;
+std::optional<uint32_t*> getHookBr(cs::decode::Insn const& insn, uint32_t const* addr) {
+    return (insn.kind == cs::decode::Kind::Br && insn.rd == ARM64_REG_X17) ? std::optional<uint32_t*>(const_cast<uint32_t*>(addr)) : std::nullopt;
 }
 
 bool HookTracker::InstructionIsHooked(const void* const location) noexcept {
     // TODO: Rewrite this using flamingo knowledge
-    auto brAddr = cs::findNth<1, &getHookBr, &cs::insnMatch<>, -1, 20>(reinterpret_cast<const uint32_t*>(location)).value();
+    // This looks for hooks that may not be tracked, so it must not read through the decoded instruction cache
+    std::array addrs{ cs::AddrSearchPair(reinterpret_cast<const uint32_t*>(location), 20, false) };
+    auto brAddr = cs::findNthDecoded(addrs, 1, -1, &getHookBr, &cs::kindMatch<>);
+    if (!brAddr) return false;
     // br should be second or third instruction, following 8 bytes should be dst to jump to.
-    return brAddr == reinterpret_cast<const uint32_t*>(location) + 1 || brAddr == reinterpret_cast<const uint32_t*>(location) + 2;
+    return *brAddr == reinterpret_cast<const uint32_t*>(location) + 1 || *brAddr == reinterpret_cast<const uint32_t*>(location) + 2;
     // // The third instruction should be a BR x17
     // Instruction instr(reinterpret_cast<const int32_t *>(location) + 2);
     // return instr.isIndirectBranch() && instr.numSourceRegisters == 1 && instr.Rs[0] == 17;
@@ -1,8 +1,16 @@
 #include <unistd.h>
 
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include "../../shared/config/config-utils.hpp"
 #include "../../shared/utils/capstone-utils.hpp"
 #include "../../shared/utils/hooking.hpp"
 #include "../../shared/utils/il2cpp-functions.hpp"
+#include "../../shared/utils/il2cpp-type-check.hpp"
 #include "../../shared/utils/logging.hpp"
 #include "capstone/shared/capstone/capstone.h"
 
@@ -490,6 +498,122 @@ static std::optional<uint32_t*> loadFind(cs_insn* insn) {
     return (insn->id == ARM64_INS_LDR || insn->id == ARM64_INS_LDP) ? std::optional<uint32_t*>(reinterpret_cast<uint32_t*>(insn->address)) : std::nullopt;
 }
 
+namespace {
+    /// @brief Persists the offsets of internal il2cpp symbols found by xref tracing, so later launches of the same libil2cpp build skip the disassembly.
+    /// Each entry is verified against a fingerprint of the code it was traced from (its anchor) before it is used.
+    class XrefCache {
+        struct Entry {
+            uintptr_t offset;
+            uintptr_t anchor;
+            uint64_t fingerprint;
+        };
+
+        static constexpr std::size_t FINGERPRINT_SIZE = 4 * sizeof(uint32_t);
+
+        std::string path;
+        std::string buildId;
+        uintptr_t base = 0;
+        std::unordered_map<std::string, Entry> entries;
+        bool dirty = false;
+
+        bool anchorValid(uintptr_t anchor) const {
+            return anchor < getLibil2cppSize() - FINGERPRINT_SIZE;
+        }
+
+        uint64_t fingerprint(uintptr_t anchor) const {
+            // FNV-1a over the first few instructions of the anchor
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            auto* bytes = reinterpret_cast<const uint8_t*>(base + anchor);
+            for (std::size_t i = 0; i < FINGERPRINT_SIZE; i++) {
+                hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+            }
+            return hash;
+        }
+
+       public:
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+
+        XrefCache(void const* libil2cppSymbol) : base(getRealOffset(nullptr)) {
+            auto const& logger = il2cpp_utils::Logger;
+            buildId = backtrace_helpers::symbolize(libil2cppSymbol).buildId;
+            if (buildId.empty()) {
+                logger.warn("XrefCache: libil2cpp.so has no build-id, xref results will not be cached!");
+                return;
+            }
+            path = getDataDir(MOD_ID) + "xref-cache.txt";
+
+            std::ifstream file(path);
+            std::string fileBuildId;
+            if (!(file >> fileBuildId) || fileBuildId != buildId) {
+                logger.debug("XrefCache: no cached xrefs for build-id {}", buildId);
+                return;
+            }
+            std::string name;
+            Entry entry;
+            while (file >> name >> std::hex >> entry.offset >> entry.anchor >> entry.fingerprint) {
+                entries.emplace(std::move(name), entry);
+            }
+            logger.debug("XrefCache: loaded {} cached xrefs for build-id {}", entries.size(), buildId);
+        }
+
+        /// @brief Sets out to the cached address of name, if there is one and its anchor still matches.
+        template <class T>
+        bool load(std::string_view name, T& out) {
+            auto itr = entries.find(std::string(name));
+            if (itr == entries.end()) {
+                misses++;
+                return false;
+            }
+            auto const& entry = itr->second;
+            if (!anchorValid(entry.anchor) || fingerprint(entry.anchor) != entry.fingerprint) {
+                il2cpp_utils::Logger.warn("XrefCache: fingerprint mismatch for {}, tracing it again", name);
+                entries.erase(itr);
+                dirty = true;
+                misses++;
+                return false;
+            }
+            out = reinterpret_cast<T>(base + entry.offset);
+            hits++;
+            return true;
+        }
+
+        /// @brief Records the traced address of name. anchor is the code the address was traced from, or the address itself for functions.
+        void store(std::string_view name, void const* value, void const* anchor) {
+            if (buildId.empty() || !value || !anchor) return;
+            auto anchorOffset = reinterpret_cast<uintptr_t>(anchor) - base;
+            if (!anchorValid(anchorOffset)) return;
+            entries.insert_or_assign(std::string(name), Entry{ reinterpret_cast<uintptr_t>(value) - base, anchorOffset, fingerprint(anchorOffset) });
+            dirty = true;
+        }
+
+        void store(std::string_view name, void const* function) {
+            store(name, function, function);
+        }
+
+        /// @brief Writes the cache back to disk if anything was traced.
+        void save() {
+            if (!dirty || path.empty()) return;
+            auto const& logger = il2cpp_utils::Logger;
+            auto dir = path.substr(0, path.rfind('/'));
+            if (!direxists(dir)) mkpath(dir);
+
+            std::string out = buildId + "\n";
+            for (auto const& [name, entry] : entries) {
+                out += fmt::format("{} {:x} {:x} {:x}\n", name, entry.offset, entry.anchor, entry.fingerprint);
+            }
+            if (!writefile(path, out)) {
+                logger.warn("XrefCache: failed to write {}", path);
+                return;
+            }
+            dirty = false;
+        }
+    };
+
+    inline long long elapsedMicros(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+}
 
 #define API_SYM(name)                                                \
     *(void**)(&il2cpp_##name) = dlsym(imagehandle, "il2cpp_" #name); \
@@ -504,6 +628,7 @@ void il2cpp_functions::Init() {
 
     // Register for paper to write file
     Paper::Logger::RegisterFileContextId(logger.tag);
+    auto const initStart = std::chrono::steady_clock::now();
 
     logger.info("il2cpp_functions: Init: Initializing all IL2CPP Functions...");
     dlerror();  // clears existing errors
@@ -790,20 +915,26 @@ void il2cpp_functions::Init() {
     *(void**)(&il2cpp_class_get_name_const) = dlsym(imagehandle, "il2cpp_class_get_name");
     logger.info("Loaded: il2cpp_class_get_name CONST VERSION!");
 
+    auto const dlsymTime = elapsedMicros(initStart);
+    auto const xrefStart = std::chrono::steady_clock::now();
+
     // XREF TRACES
+    // Every traced address is cached per libil2cpp build, see XrefCache
     // TODO: Consider making all of these optional and having only those that are truly used crash on fail
     // Alternatively, have none of them crash on fail, but on usage
-    {
+    XrefCache xrefs(reinterpret_cast<void const*>(il2cpp_init));
+    if (!xrefs.load("Class::Init", il2cpp_Class_Init)) {
         auto Array_NewSpecific_addr = cs::readb(reinterpret_cast<const uint32_t*>(il2cpp_array_new_specific));
         logger.debug("Array::NewSpecific offset: {:X}", reinterpret_cast<uintptr_t>(Array_NewSpecific_addr) - getRealOffset(0));
         auto match = cs::findNthBl<1>(Array_NewSpecific_addr);
         if (!match) SAFE_ABORT_MSG("Failed to find Class::Init!");
         il2cpp_Class_Init = reinterpret_cast<decltype(il2cpp_Class_Init)>(*match);
+        xrefs.store("Class::Init", reinterpret_cast<void const*>(il2cpp_Class_Init));
         // Class::Init. 0x846A68 in 1.5, 0x9EC0A4 in 1.7.0, 0xA6D1B8 in 1.8.0b1
         logger.debug("Class::Init found? offset: {:X}", reinterpret_cast<uintptr_t>(il2cpp_Class_Init) - getRealOffset(0));
     }
 
-    {
+    if (!xrefs.load("MetadataCache::GetTypeInfoFromHandle", il2cpp_MetadataCache_GetTypeInfoFromHandle)) {
         /*
             Path to method:
             il2cpp_image_get_class
@@ -817,11 +948,12 @@ void il2cpp_functions::Init() {
         auto MetadataCache_GetTypeInfoFromHandle_addr = cs::findNthB<1, false, -1, 1024>(*Image_GetType_addr);
         if (!MetadataCache_GetTypeInfoFromHandle_addr) SAFE_ABORT_MSG("Failed to find MetadataCache::GetTypeInfoFromHandle!");
         il2cpp_MetadataCache_GetTypeInfoFromHandle = reinterpret_cast<decltype(il2cpp_MetadataCache_GetTypeInfoFromHandle)>(*MetadataCache_GetTypeInfoFromHandle_addr);
+        xrefs.store("MetadataCache::GetTypeInfoFromHandle", reinterpret_cast<void const*>(il2cpp_MetadataCache_GetTypeInfoFromHandle));
         // MetadataCache::GetTypeInfoFromHandle. offset 0x84F764 in 1.5, 0x9F5250 in 1.7.0, 0xA7A79C in 1.8.0b1
         logger.debug("MetadataCache::GetTypeInfoFromHandle found? offset: {:X}", reinterpret_cast<uintptr_t>(il2cpp_MetadataCache_GetTypeInfoFromHandle) - getRealOffset(0));
     }
 
-    {
+    if (!xrefs.load("MetadataCache::GetTypeInfoFromTypeIndex", il2cpp_MetadataCache_GetTypeInfoFromTypeIndex)) {
         /*
             Path to method:
             il2cpp_field_get_value_object
@@ -851,11 +983,12 @@ void il2cpp_functions::Init() {
         auto MetadataCache_GetTypeInfoFromTypeIndex_addr = cs::findNthBl<2, 1>(*BlobReader_GetConstantValueFromBlob2_addr);
         if (!MetadataCache_GetTypeInfoFromTypeIndex_addr) SAFE_ABORT_MSG("Failed to find MetadataCache::GetTypeInfoFromTypeIndex!");
         il2cpp_MetadataCache_GetTypeInfoFromTypeIndex = reinterpret_cast<decltype(il2cpp_MetadataCache_GetTypeInfoFromTypeIndex)>(*MetadataCache_GetTypeInfoFromTypeIndex_addr);
+        xrefs.store("MetadataCache::GetTypeInfoFromTypeIndex", reinterpret_cast<void const*>(il2cpp_MetadataCache_GetTypeInfoFromTypeIndex));
         // MetadataCache::GetTypeInfoFromTypeIndex. offset 0x84F764 in 1.5, 0x9F5250 in 1.7.0, 0xA7A79C in 1.8.0b1
         logger.debug("MetadataCache::GetTypeInfoFromTypeIndex found? offset: {:X}", reinterpret_cast<uintptr_t>(il2cpp_MetadataCache_GetTypeInfoFromTypeIndex) - getRealOffset(0));
     }
 
-    {
+    if (!xrefs.load("GlobalMetadata::GetTypeInfoFromHandle", il2cpp_GlobalMetadata_GetTypeInfoFromHandle)) {
         /*
             Path to method:
             MetadataCache::GetTypeInfoFromHandle
@@ -865,10 +998,11 @@ void il2cpp_functions::Init() {
         auto GlobalMetadata_GetTypeInfoFromHandle_addr = cs::findNthB<1, false, -1, 1024>(reinterpret_cast<uint32_t*>(il2cpp_MetadataCache_GetTypeInfoFromHandle));
         if (!GlobalMetadata_GetTypeInfoFromHandle_addr) SAFE_ABORT_MSG("Failed to find GlobalMetadata::GetTypeInfoFromHandle!");
         il2cpp_GlobalMetadata_GetTypeInfoFromHandle = reinterpret_cast<decltype(il2cpp_GlobalMetadata_GetTypeInfoFromHandle)>(*GlobalMetadata_GetTypeInfoFromHandle_addr);
+        xrefs.store("GlobalMetadata::GetTypeInfoFromHandle", reinterpret_cast<void const*>(il2cpp_GlobalMetadata_GetTypeInfoFromHandle));
         logger.debug("GlobalMetadata::GetTypeInfoFromHandle found? offset: {:X}", reinterpret_cast<uintptr_t>(il2cpp_GlobalMetadata_GetTypeInfoFromHandle) - getRealOffset(0));
     }
 
-    {
+    if (!xrefs.load("GlobalMetadata::GetTypeInfoFromTypeDefinitionIndex", il2cpp_GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex)) {
         /*
             Path to method:
             GlobalMetadata::GetTypeInfoFromHandle
@@ -878,70 +1012,85 @@ void il2cpp_functions::Init() {
         auto GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex_addr = cs::findNthB<1, false, -1, 1024>(reinterpret_cast<uint32_t*>(il2cpp_GlobalMetadata_GetTypeInfoFromHandle));
         if (!GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex_addr) SAFE_ABORT_MSG("Failed to find GlobalMetadata::GetTypeInfoFromTypeDefinitionIndex!");
         il2cpp_GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex = reinterpret_cast<decltype(il2cpp_GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex)>(*GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex_addr);
+        xrefs.store("GlobalMetadata::GetTypeInfoFromTypeDefinitionIndex", reinterpret_cast<void const*>(il2cpp_GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex));
         logger.debug("GlobalMetadata::GetTypeInfoFromTypeDefinitionIndex found? offset: {:X}", reinterpret_cast<uintptr_t>(il2cpp_GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex) - getRealOffset(0));
     }
 
-    {
+    if (!xrefs.load("Type::GetName", il2cpp__Type_GetName_)) {
         auto type_getName = cs::findNthBl<1>(reinterpret_cast<uint32_t*>(il2cpp_type_get_assembly_qualified_name));
         if (!type_getName) SAFE_ABORT_MSG("Failed to find Type::GetName!");
         il2cpp__Type_GetName_ = reinterpret_cast<decltype(il2cpp__Type_GetName_)>(*type_getName);
+        xrefs.store("Type::GetName", reinterpret_cast<void const*>(il2cpp__Type_GetName_));
         // Type::GetName. offset 0x8735DC in 1.5, 0xA1A458 in 1.7.0, 0xA7B634 in 1.8.0b1
         logger.debug("Type::GetName found? offset: {:X}", reinterpret_cast<uintptr_t>(il2cpp__Type_GetName_) - getRealOffset(0));
     }
 
-    {
+    if (!xrefs.load("Class::FromIl2CppType", il2cpp_Class_FromIl2CppType)) {
         auto result = cs::findNthB<1, false, -1, 1024>(reinterpret_cast<uint32_t*>(il2cpp_class_from_il2cpp_type));
         if (!result) SAFE_ABORT_MSG("Failed to find Class::FromIl2CppType!");
         il2cpp_Class_FromIl2CppType = reinterpret_cast<decltype(il2cpp_Class_FromIl2CppType)>(*result);
+        xrefs.store("Class::FromIl2CppType", reinterpret_cast<void const*>(il2cpp_Class_FromIl2CppType));
         logger.debug("Class::FromIl2CppType found? offset: {:X}", ((uintptr_t)il2cpp_Class_FromIl2CppType) - getRealOffset(0));
     }
 
-    {
+    if (!xrefs.load("GenericClass::GetClass", il2cpp_GenericClass_GetClass)) {
         // GenericClass::GetClass. offset 0x88DF64 in 1.5, 0xA34F20 in 1.7.0, 0xA6E4EC in 1.8.0b1
         // Instead of evaluating the switch, we get the 6th b
         auto GenericClass_GetClass_addr = cs::findNthB<6, false, -1, 1024>(reinterpret_cast<uint32_t*>(il2cpp_Class_FromIl2CppType));
         if (!GenericClass_GetClass_addr) SAFE_ABORT_MSG("Failed to find GenericClass::GetClass!");
         il2cpp_GenericClass_GetClass = reinterpret_cast<decltype(il2cpp_GenericClass_GetClass)>(*GenericClass_GetClass_addr);
+        xrefs.store("GenericClass::GetClass", reinterpret_cast<void const*>(il2cpp_GenericClass_GetClass));
         logger.debug("GenericClass::GetClass found? offset: {:X}", ((uintptr_t)il2cpp_GenericClass_GetClass) - getRealOffset(0));
     }
 
-    {
+    if (!xrefs.load("Class::GetPtrClass", il2cpp_Class_GetPtrClass)) {
         // Class::GetPtrClass(Il2CppClass*)
         // instead of evaluating the switch, we look for the 4th b
         auto Class_GetPtrClass_addr = cs::findNthB<4, false>(reinterpret_cast<uint32_t*>(il2cpp_Class_FromIl2CppType));
         if (!Class_GetPtrClass_addr) SAFE_ABORT_MSG("Failed to find Class_GetPtrClass!");
         il2cpp_Class_GetPtrClass = reinterpret_cast<decltype(il2cpp_Class_GetPtrClass)>(*Class_GetPtrClass_addr);
+        xrefs.store("Class::GetPtrClass", reinterpret_cast<void const*>(il2cpp_Class_GetPtrClass));
         logger.debug("Class::GetPtrClass(Il2CppClass*) found? offset: {:X}", ((uintptr_t)il2cpp_Class_GetPtrClass) - getRealOffset(0));
     }
 
-    {
+    if (!xrefs.load("Assembly::GetAllAssemblies", il2cpp_Assembly_GetAllAssemblies)) {
         // Assembly::GetAllAssemblies
         auto result = cs::findNthBl<1>(reinterpret_cast<const uint32_t*>(il2cpp_domain_get_assemblies));
         if (!result) SAFE_ABORT_MSG("Failed to find Assembly::GetAllAssemblies!");
         il2cpp_Assembly_GetAllAssemblies = reinterpret_cast<decltype(il2cpp_Assembly_GetAllAssemblies)>(*result);
+        xrefs.store("Assembly::GetAllAssemblies", reinterpret_cast<void const*>(il2cpp_Assembly_GetAllAssemblies));
         logger.debug("Assembly::GetAllAssemblies found? offset: {:X}", ((uintptr_t)il2cpp_Assembly_GetAllAssemblies) - getRealOffset(0));
     }
 
     {
         CRASH_UNLESS(il2cpp_shutdown);
         // GC_free
-        if (find_GC_free()) {
+        if (!xrefs.load("GC_free", il2cpp_GC_free) && find_GC_free()) {
             logger.debug("gc::GarbageCollector::FreeFixed found? offset: {:X}", ((uintptr_t)il2cpp_GC_free) - getRealOffset(0));
+            xrefs.store("GC_free", reinterpret_cast<void const*>(il2cpp_GC_free));
         }
         // GarbageCollector::SetWriteBarrier(void*)
-        if (find_GC_SetWriteBarrier(reinterpret_cast<const uint32_t*>(il2cpp_gc_wbarrier_set_field))) {
+        if (!xrefs.load("GarbageCollector::SetWriteBarrier", il2cpp_GarbageCollector_SetWriteBarrier) &&
+            find_GC_SetWriteBarrier(reinterpret_cast<const uint32_t*>(il2cpp_gc_wbarrier_set_field))) {
             logger.debug("GarbageCollector::SetWriteBarrier found? offset: {:X}", ((uintptr_t)il2cpp_GarbageCollector_SetWriteBarrier) - getRealOffset(0));
+            xrefs.store("GarbageCollector::SetWriteBarrier", reinterpret_cast<void const*>(il2cpp_GarbageCollector_SetWriteBarrier));
         }
         // GarbageCollector::AllocateFixed(size_t, void*)
-        auto result = cs::findNthB<1>(reinterpret_cast<const uint32_t*>(il2cpp_domain_get));
-        if (!result) SAFE_ABORT_MSG("Failed to find Domain::Get!");
-        if (find_GC_AllocFixed(*result)) {
-            logger.debug("GarbageCollector::AllocateFixed found? offset: {:X}", ((uintptr_t)il2cpp_GarbageCollector_AllocateFixed) - getRealOffset(0));
+        if (!xrefs.load("GarbageCollector::AllocateFixed", il2cpp_GarbageCollector_AllocateFixed)) {
+            auto result = cs::findNthB<1>(reinterpret_cast<const uint32_t*>(il2cpp_domain_get));
+            if (!result) SAFE_ABORT_MSG("Failed to find Domain::Get!");
+            if (find_GC_AllocFixed(*result)) {
+                logger.debug("GarbageCollector::AllocateFixed found? offset: {:X}", ((uintptr_t)il2cpp_GarbageCollector_AllocateFixed) - getRealOffset(0));
+                // the signature scan fallback installs a wrapper that lives in this library, which cannot be cached
+                if (il2cpp_GarbageCollector_AllocateFixed != &__wrapper_gc_malloc_uncollectable) {
+                    xrefs.store("GarbageCollector::AllocateFixed", reinterpret_cast<void const*>(il2cpp_GarbageCollector_AllocateFixed));
+                }
+            }
         }
     }
     hasGCFuncs = il2cpp_GarbageCollector_AllocateFixed != nullptr && il2cpp_GC_free != nullptr;
 
-    {
+    if (!xrefs.load("il2cpp_defaults", defaults)) {
         /*
             il2cpp_init
             Runtime::Init -> 2nd bl
@@ -957,24 +1106,36 @@ void il2cpp_functions::Init() {
         if (!defaults_addr) SAFE_ABORT_MSG("Failed to find pcaddr around 8th load in Runtime::Init!");
         defaults = reinterpret_cast<decltype(defaults)>(std::get<2>(*defaults_addr));
         logger.debug("il2cpp_defaults found: {} (offset: {:X})", fmt::ptr(defaults), ((uintptr_t)defaults) - getRealOffset(0));
+        xrefs.store("il2cpp_defaults", defaults, *runtimeInit);
+    }
 
-        // FIELDS
-        // Extract locations of s_GlobalMetadataHeader, s_Il2CppMetadataRegistration, & s_GlobalMetadata
-
-        auto tmp = cs::getpcaddr<3, 1>(reinterpret_cast<const uint32_t*>(il2cpp_GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex));
+    // FIELDS
+    // Extract locations of s_GlobalMetadataHeader, s_Il2CppMetadataRegistration, & s_GlobalMetadata
+    if (!xrefs.load("s_GlobalMetadataHeaderPtr", s_GlobalMetadataHeaderPtr) || !xrefs.load("s_Il2CppMetadataRegistrationPtr", s_Il2CppMetadataRegistrationPtr) ||
+        !xrefs.load("s_GlobalMetadataPtr", s_GlobalMetadataPtr)) {
+        auto const* anchor = reinterpret_cast<const uint32_t*>(il2cpp_GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex);
+        auto tmp = cs::getpcaddr<3, 1>(anchor);
         if (!tmp) SAFE_ABORT_MSG("Failed to find 3rd pcaddr for s_GlobalMetadataHeaderPtr!");
         s_GlobalMetadataHeaderPtr = reinterpret_cast<decltype(s_GlobalMetadataHeaderPtr)>(std::get<2>(*tmp));
 
-        tmp = cs::getpcaddr<4, 1>(reinterpret_cast<const uint32_t*>(il2cpp_GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex));
+        tmp = cs::getpcaddr<4, 1>(anchor);
         if (!tmp) SAFE_ABORT_MSG("Failed to find 4th pcaddr for s_Il2CppMetadataRegistrationPtr!");
         s_Il2CppMetadataRegistrationPtr = reinterpret_cast<decltype(s_Il2CppMetadataRegistrationPtr)>(std::get<2>(*tmp));
 
-        tmp = cs::getpcaddr<5, 1>(reinterpret_cast<const uint32_t*>(il2cpp_GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex));
+        tmp = cs::getpcaddr<5, 1>(anchor);
         if (!tmp) SAFE_ABORT_MSG("Failed to find 5th pcaddr for s_GlobalMetadataPtr!");
         s_GlobalMetadataPtr = reinterpret_cast<decltype(s_GlobalMetadataPtr)>(std::get<2>(*tmp));
         logger.debug("{} {} {} metadata pointers", fmt::ptr(s_GlobalMetadataHeaderPtr), fmt::ptr(s_Il2CppMetadataRegistrationPtr), fmt::ptr(s_GlobalMetadataPtr));
-        logger.debug("All global constants found!");
+        xrefs.store("s_GlobalMetadataHeaderPtr", s_GlobalMetadataHeaderPtr, anchor);
+        xrefs.store("s_Il2CppMetadataRegistrationPtr", s_Il2CppMetadataRegistrationPtr, anchor);
+        xrefs.store("s_GlobalMetadataPtr", s_GlobalMetadataPtr, anchor);
     }
+    logger.debug("All global constants found!");
+
+    auto const xrefTime = elapsedMicros(xrefStart);
+    auto const saveStart = std::chrono::steady_clock::now();
+    xrefs.save();
+    auto const saveTime = elapsedMicros(saveStart);
 
     // WeakPtr stuff somewhere
 
@@ -990,4 +1151,11 @@ void il2cpp_functions::Init() {
 
     initialized = true;
     logger.info("il2cpp_functions: Init: Successfully loaded all il2cpp functions!");
+    logger.info("il2cpp_functions: Init: took {}us (dlsym: {}us, xrefs: {}us with {} cached and {} traced, cache write: {}us)", elapsedMicros(initStart), dlsymTime, xrefTime,
+                xrefs.hits, xrefs.misses, saveTime);
+
+    // classof needs the metadata, which is only registered once il2cpp_init has run; if it has not, classof resolves lazily
+    if (*s_Il2CppMetadataRegistrationPtr) {
+        il2cpp_utils::ResolveClassofSlots();
+    }
 }
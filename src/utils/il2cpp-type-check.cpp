@@ -1,7 +1,11 @@
 #include "../../shared/utils/il2cpp-type-check.hpp"
 #include "../../shared/utils/il2cpp-utils.hpp"
 #include "../../shared/utils/hashing.hpp"
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace il2cpp_utils {
     std::vector<Il2CppClass*> ClassesFrom(std::span<std::string_view> const strings) {
@@ -27,8 +31,55 @@ namespace il2cpp_utils {
         return types;
     }
 
+    namespace {
+        struct ClassofSlot {
+            std::atomic<Il2CppClass*>* slot;
+            Il2CppClass* (*resolve)();
+        };
+
+        // Function local, so that slots registering from other translation units' static initializers find it constructed
+        std::vector<ClassofSlot>& ClassofTable() {
+            static std::vector<ClassofSlot> table;
+            return table;
+        }
+        std::mutex& ClassofTableLock() {
+            static std::mutex lock;
+            return lock;
+        }
+    }
+
+    void RegisterClassofSlot(std::atomic<Il2CppClass*>* slot, Il2CppClass* (*resolve)()) {
+        std::lock_guard lock(ClassofTableLock());
+        ClassofTable().push_back({ slot, resolve });
+    }
+
+    std::size_t ResolveClassofSlots() {
+        il2cpp_functions::Init();
+        auto const& logger = il2cpp_utils::Logger;
+        static std::mutex resolveLock;
+        std::lock_guard resolveGuard(resolveLock);
+        auto start = std::chrono::steady_clock::now();
+
+        // Resolve outside of the table lock, so that slots may keep registering meanwhile
+        std::vector<ClassofSlot> pending;
+        {
+            std::lock_guard tableLock(ClassofTableLock());
+            for (auto const& entry : ClassofTable()) {
+                if (!entry.slot->load(std::memory_order_relaxed)) pending.push_back(entry);
+            }
+        }
+
+        std::size_t failed = 0;
+        for (auto const& entry : pending) {
+            if (!entry.resolve()) failed++;
+        }
+        logger.info("Resolved {} classof slots ({} failed) in {}us", pending.size() - failed, failed,
+                    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        return failed;
+    }
+
     // It doesn't matter what types these are, they just need to be used correctly within the methods
-    static std::unordered_map<std::pair<std::string, std::string>, Il2CppClass*, hash_pair> namesToClassesCache;
+    static std::unordered_map<std::pair<hashed_string, hashed_string>, Il2CppClass*, hash_pair, equal_pair> namesToClassesCache;
     static std::mutex nameHashLock;
 
     Il2CppClass* FindNested(Il2CppClass* declaring, std::string_view typeName) {
@@ -56,13 +107,17 @@ namespace il2cpp_utils {
         }
     }
 
+    hash_table_stats GetClassNameCacheStats() {
+        std::lock_guard lock(nameHashLock);
+        return get_hash_stats(namesToClassesCache);
+    }
+
     Il2CppClass* GetClassFromName(std::string_view name_space, std::string_view type_name) {
         il2cpp_functions::Init();
         auto const& logger = il2cpp_utils::Logger;
 
-        // TODO: avoid creating std::string at any point except new pair insertion via P0919
-        // Check cache
-        auto key = std::pair<std::string, std::string>(name_space, type_name);
+        // Check cache, only creating strings when inserting
+        auto key = std::pair<hashed_string_view, hashed_string_view>(name_space, type_name);
         nameHashLock.lock();
         auto itr = namesToClassesCache.find(key);
         if (itr != namesToClassesCache.end()) {
@@ -84,7 +139,7 @@ namespace il2cpp_utils {
             auto klass = il2cpp_functions::class_from_name(img, name_space.data(), type_name.data());
             if (klass) {
                 nameHashLock.lock();
-                namesToClassesCache.emplace(key, klass);
+                namesToClassesCache.emplace(std::pair<hashed_string, hashed_string>(key.first, key.second), klass);
                 nameHashLock.unlock();
                 return klass;
             }
@@ -103,7 +158,7 @@ namespace il2cpp_utils {
 
             if (klass) {
                 nameHashLock.lock();
-                namesToClassesCache.emplace(key, klass);
+                namesToClassesCache.emplace(std::pair<hashed_string, hashed_string>(key.first, key.second), klass);
                 nameHashLock.unlock();
                 return klass;
             }
@@ -114,33 +169,93 @@ namespace il2cpp_utils {
         return nullptr;
     }
 
-    Il2CppClass* MakeGeneric(const Il2CppClass* klass, std::span<const Il2CppClass* const> const args) {
-        il2cpp_functions::Init();
-        auto const& logger = il2cpp_utils::Logger;
+    namespace {
+        // Generic definition followed by its arguments
+        using GenericKey = std::vector<const Il2CppClass*>;
 
-        static auto typ = RET_0_UNLESS(logger, il2cpp_functions::defaults->systemtype_class);
-        auto klassType = RET_0_UNLESS(logger, GetSystemType(klass));
+        struct GenericKeyHash {
+            std::size_t operator()(GenericKey const& key) const noexcept {
+                std::size_t seed = key.size();
+                for (auto* klass : key) {
+                    seed = hash_combine(seed, std::hash<const Il2CppClass*>{}(klass));
+                }
+                return seed;
+            }
+        };
 
-        // Call Type.MakeGenericType on it
-        auto arr = il2cpp_functions::array_new_specific(typ, args.size());
-        if (!arr) {
-            logger.error("[MakeGeneric] Failed to make new array with length: {}", args.size());
+        std::shared_mutex genericsLock;
+        std::unordered_map<GenericKey, Il2CppClass*, GenericKeyHash> genericInstantiations;
+
+        // Finds the instantiation among the ones il2cpp was compiled with, which are interned, so this is the same class reflection would return
+        Il2CppClass* InflateNative(const Il2CppClass* klass, std::span<const Il2CppClass* const> args) {
+            for (auto* genClass : GetGenericInstantiations(klass)) {
+                auto* inst = genClass->context.class_inst;
+                if (inst->type_argc != args.size()) continue;
+                bool match = true;
+                for (size_t i = 0; i < args.size() && match; i++) {
+                    match = il2cpp_functions::class_from_type(inst->type_argv[i]) == args[i];
+                }
+                if (match) {
+                    return il2cpp_functions::GenericClass_GetClass(genClass);
+                }
+            }
             return nullptr;
         }
 
-        int i = 0;
-        for (auto arg : args) {
-            auto* o = GetSystemType(arg);
-            if (!o) {
-                logger.error("[MakeGeneric] Failed to get type for {}", il2cpp_functions::class_get_name_const(arg));
+        Il2CppClass* InflateReflection(const Il2CppClass* klass, std::span<const Il2CppClass* const> args) {
+            auto const& logger = il2cpp_utils::Logger;
+
+            static auto typ = RET_0_UNLESS(logger, il2cpp_functions::defaults->systemtype_class);
+            auto klassType = RET_0_UNLESS(logger, GetSystemType(klass));
+
+            // Call Type.MakeGenericType on it
+            auto arr = il2cpp_functions::array_new_specific(typ, args.size());
+            if (!arr) {
+                logger.error("[MakeGeneric] Failed to make new array with length: {}", args.size());
                 return nullptr;
             }
-            il2cpp_array_set(arr, void*, i, reinterpret_cast<void*>(o));
-            i++;
+
+            int i = 0;
+            for (auto arg : args) {
+                auto* o = GetSystemType(arg);
+                if (!o) {
+                    logger.error("[MakeGeneric] Failed to get type for {}", il2cpp_functions::class_get_name_const(arg));
+                    return nullptr;
+                }
+                il2cpp_array_set(arr, void*, i, reinterpret_cast<void*>(o));
+                i++;
+            }
+
+            auto* reflection_type = RET_0_UNLESS(logger, MakeGenericType(reinterpret_cast<Il2CppReflectionType*>(klassType), arr));
+            auto* ret = RET_0_UNLESS(logger, il2cpp_functions::class_from_system_type(reflection_type));
+            return ret;
         }
+    }  // namespace
+
+    Il2CppClass* MakeGeneric(const Il2CppClass* klass, std::span<const Il2CppClass* const> const args) {
+        il2cpp_functions::Init();
+        auto const& logger = il2cpp_utils::Logger;
+        RET_0_UNLESS(logger, klass);
 
-        auto* reflection_type = RET_0_UNLESS(logger, MakeGenericType(reinterpret_cast<Il2CppReflectionType*>(klassType), arr));
-        auto* ret = RET_0_UNLESS(logger, il2cpp_functions::class_from_system_type(reflection_type));
+        GenericKey key;
+        key.reserve(args.size() + 1);
+        key.push_back(klass);
+        key.insert(key.end(), args.begin(), args.end());
+        {
+            std::shared_lock lock(genericsLock);
+            auto itr = genericInstantiations.find(key);
+            if (itr != genericInstantiations.end()) return itr->second;
+        }
+
+        // Only fall back to Type.MakeGenericType for instantiations il2cpp was not compiled with
+        auto* ret = InflateNative(klass, args);
+        if (!ret) {
+            ret = InflateReflection(klass, args);
+        }
+        if (ret) {
+            std::unique_lock lock(genericsLock);
+            genericInstantiations.emplace(std::move(key), ret);
+        }
         return ret;
     }
 
@@ -148,29 +263,15 @@ namespace il2cpp_utils {
         il2cpp_functions::Init();
         auto const& logger = il2cpp_utils::Logger;
 
-        static auto typ = RET_0_UNLESS(logger, il2cpp_functions::defaults->systemtype_class);
-        auto klassType = RET_0_UNLESS(logger, GetSystemType(klass));
-
-        // Call Type.MakeGenericType on it
-        auto arr = il2cpp_functions::array_new_specific(typ, numTypes);
-        if (!arr) {
-            logger.error("Failed to make new array with length: {}", numTypes);
-            return nullptr;
-        }
-
+        std::vector<const Il2CppClass*> args(numTypes);
         for (size_t i = 0; i < numTypes; i++) {
-            const Il2CppType* arg = types[i];
-            auto* o = GetSystemType(arg);
-            if (!o) {
-                logger.error("Failed to get system type for {}", il2cpp_functions::type_get_name(arg));
+            args[i] = il2cpp_functions::class_from_type(types[i]);
+            if (!args[i]) {
+                logger.error("Failed to get class for {}", il2cpp_functions::type_get_name(types[i]));
                 return nullptr;
             }
-            il2cpp_array_set(arr, void*, i, reinterpret_cast<void*>(o));
         }
-
-        auto* reflection_type = RET_0_UNLESS(logger, MakeGenericType(reinterpret_cast<Il2CppReflectionType*>(klassType), arr));
-        auto* ret = RET_0_UNLESS(logger, il2cpp_functions::class_from_system_type(reflection_type));
-        return ret;
+        return MakeGeneric(klass, std::span<const Il2CppClass* const>(args));
     }
 }
 check_size<sizeof(Il2CppObject), 0x10> il2cppObjectCheck;
@@ -3,15 +3,19 @@
 #include "../../shared/utils/il2cpp-utils-methods.hpp"
 #include "../../shared/utils/il2cpp-utils-properties.hpp"
 #include "../../shared/utils/il2cpp-utils-fields.hpp"
-#include <map>
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include "../../shared/utils/alphanum.hpp"
 #include "shared/utils/gc-alloc.hpp"
 
 namespace il2cpp_utils {
-    static int indent = -1;
-    static int maxIndent;
+    // Per thread, so that classes logged from several threads at once are indented by their own depth
+    static thread_local int indent = -1;
+    static thread_local int maxIndent;
     std::unordered_set<Il2CppClass*> loggedClasses;
+    static std::mutex loggedClassesLock;
 
     std::string GenericClassStandardName(Il2CppGenericClass* genClass) {
         if (genClass->cached_class) {
@@ -29,11 +33,13 @@ namespace il2cpp_utils {
         il2cpp_functions::Init();
         RET_V_UNLESS(logger, klass);
 
-        if (loggedClasses.count(klass)) {
-            logger.debug("Already logged {}!", fmt::ptr(klass));
-            return;
+        {
+            std::lock_guard lock(loggedClassesLock);
+            if (!loggedClasses.insert(klass).second) {
+                logger.debug("Already logged {}!", fmt::ptr(klass));
+                return;
+            }
         }
-        loggedClasses.insert(klass);
 
         RET_V_UNLESS(logger, klass->klass == klass);  // otherwise, klass is likely NOT an Il2CppClass*!
         RET_V_UNLESS(logger, klass->name);  // ditto
@@ -155,36 +161,46 @@ namespace il2cpp_utils {
         indent--;
     }
 
-    static std::unordered_map<Il2CppClass*, std::map<std::string, Il2CppGenericClass*, doj::alphanum_less<std::string>>> classToGenericClassMap;
-    void BuildGenericsMap() {
+    // Instantiations in the metadata registration, by generic definition, in registration order
+    static std::unordered_map<const Il2CppClass*, std::vector<Il2CppGenericClass*>> classToGenericClassMap;
+    // Number of metadata registration entries already in classToGenericClassMap
+    static int32_t genericClassesIndexed = 0;
+    static std::shared_mutex genericsMapLock;
+
+    // Indexes the entries of the metadata registration which have not been indexed yet, so the map is built once and only extended afterwards
+    static void UpdateGenericsMap() {
         auto const& logger = il2cpp_utils::Logger;
         il2cpp_functions::Init();
         auto* metadataReg = RET_V_UNLESS(logger, il2cpp_functions::s_Il2CppMetadataRegistration);
-        logger.debug("metadataReg: {}, offset = {:X}", fmt::ptr(metadataReg), ((uintptr_t)metadataReg) - getRealOffset(0));
-
-        int uncached_class_count = 0;
-        for (int i=0; i < metadataReg->genericClassesCount; i++) {
-            Il2CppGenericClass* genClass = metadataReg->genericClasses[i];
-            if (!genClass) continue;
-            if (!(genClass->cached_class)) {
-                uncached_class_count++;
-            }
-            std::string genClassName = GenericClassStandardName(genClass);
-
-            auto* typeDefClass = il2cpp_functions::GlobalMetadata_GetTypeInfoFromTypeDefinitionIndex(il2cpp_functions::MetadataCache_GetIndexForTypeDefinition(genClass->cached_class));
-            if (!typeDefClass) continue;
-
-            classToGenericClassMap[typeDefClass][genClassName.c_str()] = genClass;
+        {
+            std::shared_lock lock(genericsMapLock);
+            if (genericClassesIndexed >= metadataReg->genericClassesCount) return;
         }
-        logger.debug("uncached_class_count: {} ({} proportion of total)", uncached_class_count, uncached_class_count * 1.0 / metadataReg->genericClassesCount);
+        std::unique_lock lock(genericsMapLock);
+        auto first = genericClassesIndexed;
+        for (auto i = first; i < metadataReg->genericClassesCount; i++) {
+            auto* genClass = metadataReg->genericClasses[i];
+            if (!genClass || !genClass->context.class_inst) continue;
+            auto* definition = il2cpp_type_check::GetGenericTemplateClass(genClass);
+            classToGenericClassMap[definition].push_back(genClass);
+        }
+        genericClassesIndexed = std::max(genericClassesIndexed, metadataReg->genericClassesCount);
+        logger.debug("Indexed {} generic instantiations of {} generic definitions", genericClassesIndexed - first, classToGenericClassMap.size());
+    }
+
+    std::vector<Il2CppGenericClass*> GetGenericInstantiations(const Il2CppClass* klass) {
+        UpdateGenericsMap();
+        std::shared_lock lock(genericsMapLock);
+        auto itr = classToGenericClassMap.find(klass);
+        if (itr == classToGenericClassMap.end()) return {};
+        return itr->second;
     }
 
     void LogClasses(Paper::LoggerContext const& logger, std::string_view classPrefix, bool logParents) noexcept {
         il2cpp_functions::Init();
-        BuildGenericsMap();
 
         // Begin prefix matching
-        std::map<std::string, Il2CppClass*, doj::alphanum_less<std::string>> matches;
+        std::vector<std::pair<std::string, Il2CppClass*>> matches;
         // Get il2cpp domain
         auto* dom = il2cpp_functions::domain_get();
         // Get all il2cpp assemblies
@@ -229,18 +245,28 @@ namespace il2cpp_utils {
                     // Starts with!
                     // Convert TypeDefinitionIndex --> class
                     auto klazz = il2cpp_functions::MetadataCache_GetTypeInfoFromHandle(itr->second);
-                    matches[ClassStandardName(klazz)] = klazz;
+                    matches.emplace_back(ClassStandardName(klazz), klazz);
                 }
             }
         }
 
+        // Sorted once by precomputed keys, rather than comparing names on every insertion
+        doj::alphanum_sort(std::span(matches), &std::pair<std::string, Il2CppClass*>::first);
+        matches.erase(std::unique(matches.begin(), matches.end(), [](auto const& a, auto const& b) { return a.first == b.first; }), matches.end());
+
         usleep(1000);  // 0.001s
         logger.debug("LogClasses:");
         for ( const auto &pair : matches ) {
             LogClass(logger, pair.second, logParents);
             indent = -1;
-            for ( const auto &genPair : classToGenericClassMap[pair.second] ) {
-                logger.debug("{}", genPair.first.c_str());
+            // Only the instantiations of matching classes are named, then sorted as before
+            std::vector<std::string> genericNames;
+            for (auto* genClass : GetGenericInstantiations(pair.second)) {
+                genericNames.push_back(GenericClassStandardName(genClass));
+            }
+            doj::alphanum_sort(std::span(genericNames));
+            for (auto const& name : genericNames) {
+                logger.debug("{}", name.c_str());
             }
             usleep(1000);  // 0.001s
         }
@@ -0,0 +1,248 @@
+#include "../../shared/utils/typedefs.h"
+#include "../../shared/utils/il2cpp-utils-dump.hpp"
+#include "../../shared/utils/il2cpp-utils.hpp"
+#include "../../shared/utils/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+namespace il2cpp_utils {
+    namespace {
+        // Appends whole lines to a file shared between threads, each of which buffers its own lines
+        struct DumpFile {
+            int fd = -1;
+            std::mutex lock;
+            std::atomic_size_t bytes = 0;
+            std::atomic_bool failed = false;
+
+            bool write(std::string_view data) {
+                std::lock_guard guard(lock);
+                while (!data.empty()) {
+                    auto written = ::write(fd, data.data(), data.size());
+                    if (written < 0) {
+                        if (errno == EINTR) continue;
+                        failed = true;
+                        return false;
+                    }
+                    bytes += written;
+                    data.remove_prefix(written);
+                }
+                return true;
+            }
+        };
+
+        void AppendJsonString(std::string& out, std::string_view str) {
+            out += '"';
+            for (char c : str) {
+                switch (c) {
+                    case '"': out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\r': out += "\\r"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+                        } else {
+                            out += c;
+                        }
+                }
+            }
+            out += '"';
+        }
+
+        void AppendJsonString(std::string& out, const char* str) {
+            AppendJsonString(out, std::string_view(str ? str : ""));
+        }
+
+        void AppendTypeName(std::string& out, const Il2CppType* type) {
+            if (!type) {
+                out += "null";
+                return;
+            }
+            auto* name = il2cpp_functions::type_get_name(type);
+            AppendJsonString(out, name);
+            il2cpp_functions::free(name);
+        }
+
+        bool StartsWith(const char* str, std::string_view prefix) {
+            return prefix.empty() || (str && std::string_view(str).starts_with(prefix));
+        }
+
+        void AppendClass(std::string& out, std::string_view assembly, Il2CppClass* klass, ClassDumpOptions const& options) {
+            out += "{\"assembly\":";
+            AppendJsonString(out, assembly);
+            out += ",\"name\":";
+            AppendJsonString(out, ClassStandardName(klass));
+            out += ",\"parent\":";
+            if (auto* parent = il2cpp_functions::class_get_parent(klass)) {
+                AppendJsonString(out, ClassStandardName(parent));
+            } else {
+                out += "null";
+            }
+            fmt::format_to(std::back_inserter(out), ",\"token\":{},\"flags\":{},\"valueType\":{}", il2cpp_functions::class_get_type_token(klass),
+                il2cpp_functions::class_get_flags(klass), il2cpp_functions::class_is_valuetype(klass));
+
+            void* iter;
+            if (options.fields) {
+                out += ",\"fields\":[";
+                iter = nullptr;
+                bool first = true;
+                while (auto* field = il2cpp_functions::class_get_fields(klass, &iter)) {
+                    if (!first) out += ',';
+                    first = false;
+                    out += "{\"name\":";
+                    AppendJsonString(out, il2cpp_functions::field_get_name(field));
+                    out += ",\"type\":";
+                    AppendTypeName(out, il2cpp_functions::field_get_type(field));
+                    fmt::format_to(std::back_inserter(out), ",\"offset\":{},\"flags\":{}}}", il2cpp_functions::field_get_offset(field), il2cpp_functions::field_get_flags(field));
+                }
+                out += ']';
+            }
+            if (options.properties) {
+                out += ",\"properties\":[";
+                iter = nullptr;
+                bool first = true;
+                while (auto* prop = il2cpp_functions::class_get_properties(klass, &iter)) {
+                    if (!first) out += ',';
+                    first = false;
+                    auto* getter = il2cpp_functions::property_get_get_method(prop);
+                    auto* setter = il2cpp_functions::property_get_set_method(prop);
+                    out += "{\"name\":";
+                    AppendJsonString(out, il2cpp_functions::property_get_name(prop));
+                    out += ",\"type\":";
+                    AppendTypeName(out, getter ? il2cpp_functions::method_get_return_type(getter) : (setter && setter->parameters_count ? il2cpp_functions::method_get_param(setter, setter->parameters_count - 1) : nullptr));
+                    out += ",\"get\":";
+                    AppendJsonString(out, getter ? il2cpp_functions::method_get_name(getter) : nullptr);
+                    out += ",\"set\":";
+                    AppendJsonString(out, setter ? il2cpp_functions::method_get_name(setter) : nullptr);
+                    out += '}';
+                }
+                out += ']';
+            }
+            if (options.methods) {
+                out += ",\"methods\":[";
+                iter = nullptr;
+                bool first = true;
+                while (auto* method = il2cpp_functions::class_get_methods(klass, &iter)) {
+                    if (!first) out += ',';
+                    first = false;
+                    out += "{\"name\":";
+                    AppendJsonString(out, il2cpp_functions::method_get_name(method));
+                    out += ",\"return\":";
+                    AppendTypeName(out, il2cpp_functions::method_get_return_type(method));
+                    out += ",\"params\":[";
+                    for (uint32_t i = 0; i < method->parameters_count; i++) {
+                        if (i) out += ',';
+                        out += "{\"name\":";
+                        AppendJsonString(out, il2cpp_functions::method_get_param_name(method, i));
+                        out += ",\"type\":";
+                        AppendTypeName(out, il2cpp_functions::method_get_param(method, i));
+                        out += '}';
+                    }
+                    uint32_t iflags = 0;
+                    auto flags = il2cpp_functions::method_get_flags(method, &iflags);
+                    auto offset = method->methodPointer ? reinterpret_cast<uintptr_t>(method->methodPointer) - getRealOffset(0) : 0;
+                    fmt::format_to(std::back_inserter(out), "],\"flags\":{},\"implFlags\":{},\"offset\":\"0x{:X}\"}}", flags, iflags, offset);
+                }
+                out += ']';
+            }
+            out += "}\n";
+        }
+
+        // Dumps the matching classes of one assembly, flushing whenever the buffer fills up
+        std::size_t DumpAssembly(const Il2CppAssembly* assembly, ClassDumpOptions const& options, std::string& buffer, DumpFile& file) {
+            auto const& logger = il2cpp_utils::Logger;
+            auto* image = il2cpp_functions::assembly_get_image(assembly);
+            if (!image) {
+                logger.warn("DumpClasses: assembly {} has no image! Skipping.", assembly->aname.name);
+                return 0;
+            }
+            std::size_t classes = 0;
+            auto count = il2cpp_functions::image_get_class_count(image);
+            for (std::size_t i = 0; i < count && !file.failed; i++) {
+                auto* klass = const_cast<Il2CppClass*>(il2cpp_functions::image_get_class(image, i));
+                if (!klass) continue;
+                if (!StartsWith(il2cpp_functions::class_get_name(klass), options.classPrefix)) continue;
+                if (!StartsWith(il2cpp_functions::class_get_namespace(klass), options.namespacePrefix)) continue;
+                if (options.filter && !options.filter(klass)) continue;
+
+                AppendClass(buffer, assembly->aname.name, klass, options);
+                classes++;
+                if (buffer.size() >= options.bufferSize) {
+                    file.write(buffer);
+                    buffer.clear();
+                }
+            }
+            return classes;
+        }
+    }
+
+    std::optional<ClassDumpStats> DumpClasses(std::string_view path, ClassDumpOptions const& options) {
+        auto const& logger = il2cpp_utils::Logger;
+        il2cpp_functions::Init();
+        auto start = std::chrono::steady_clock::now();
+
+        // Select the assemblies up front, so each thread can take the next one
+        std::size_t size = 0;
+        auto** assemblies = il2cpp_functions::domain_get_assemblies(il2cpp_functions::domain_get(), &size);
+        std::vector<const Il2CppAssembly*> selected;
+        for (std::size_t i = 0; i < size; i++) {
+            if (!assemblies[i]) continue;
+            if (!options.assemblies.empty() && std::find(options.assemblies.begin(), options.assemblies.end(), assemblies[i]->aname.name) == options.assemblies.end()) continue;
+            selected.push_back(assemblies[i]);
+        }
+
+        DumpFile file;
+        file.fd = ::open(std::string(path).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (file.fd < 0) {
+            logger.error("DumpClasses: could not open {}: {}", path, strerror(errno));
+            return std::nullopt;
+        }
+
+        auto threadCount = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+        threadCount = std::clamp<std::size_t>(threadCount, 1, std::max<std::size_t>(selected.size(), 1));
+
+        std::atomic_size_t next = 0;
+        std::atomic_size_t classes = 0;
+        auto work = [&]() {
+            // Class_Init and property/method setup may run on these threads, so il2cpp must know about them
+            auto* thread = il2cpp_functions::thread_attach(il2cpp_functions::domain_get());
+            std::string buffer;
+            buffer.reserve(options.bufferSize);
+            for (auto i = next++; i < selected.size() && !file.failed; i = next++) {
+                classes += DumpAssembly(selected[i], options, buffer, file);
+            }
+            if (!buffer.empty()) file.write(buffer);
+            il2cpp_functions::thread_detach(thread);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; i++) {
+            threads.emplace_back(work);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        bool closed = ::close(file.fd) == 0;
+
+        if (file.failed || !closed) {
+            logger.error("DumpClasses: failed to write {}: {}", path, strerror(errno));
+            return std::nullopt;
+        }
+        ClassDumpStats stats{
+            .assemblies = selected.size(),
+            .classes = classes,
+            .bytes = file.bytes,
+            .elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start),
+        };
+        logger.info("DumpClasses: wrote {} classes of {} assemblies ({} bytes) to {} in {}ms", stats.classes, stats.assemblies, stats.bytes, path, stats.elapsed.count());
+        return stats;
+    }
+}
@@ -1,5 +1,8 @@
 #include "../../shared/utils/il2cpp-utils-exceptions.hpp"
 #include "../../shared/utils/il2cpp-functions.hpp"
+#include "../../shared/utils/il2cpp-utils.hpp"
+#include <algorithm>
+#include <atomic>
 
 namespace il2cpp_utils {
     // Init all of the usable il2cpp API, if it has yet to be initialized
@@ -27,42 +30,118 @@ namespace il2cpp_utils {
     }
     #endif
 
+    static std::atomic<uint16_t> backtraceDepth = exceptions::MAX_STACK_TRACE_SIZE;
+    static std::atomic<uint32_t> backtraceSampleRate = 1;
+    static std::atomic<uint32_t> backtraceSampleCounter = 0;
+
+    void exceptions::SetBacktraceCapture(uint16_t depth, uint32_t sampleRate) noexcept {
+        backtraceDepth.store(std::min(depth, MAX_STACK_TRACE_SIZE), std::memory_order_relaxed);
+        backtraceSampleRate.store(std::max(sampleRate, 1u), std::memory_order_relaxed);
+    }
+
+    uint16_t exceptions::GetBacktraceCaptureDepth() noexcept {
+        return backtraceDepth.load(std::memory_order_relaxed);
+    }
+
+    uint32_t exceptions::GetBacktraceSampleRate() noexcept {
+        return backtraceSampleRate.load(std::memory_order_relaxed);
+    }
+
+    exceptions::CapturedBacktrace exceptions::CapturedBacktrace::capture(uint16_t skip) noexcept {
+        auto depth = backtraceDepth.load(std::memory_order_relaxed);
+        if (depth == 0) return {};
+        auto sampleRate = backtraceSampleRate.load(std::memory_order_relaxed);
+        if (sampleRate > 1 && backtraceSampleCounter.fetch_add(1, std::memory_order_relaxed) % sampleRate != 0) return {};
+
+        // Capture onto the stack first, so that the heap allocation is exactly as large as the captured backtrace
+        void* buffer[MAX_STACK_TRACE_SIZE];
+        // Skip this frame as well as the requested number of frames
+        uint16_t size = backtrace_helpers::captureBacktrace(buffer, depth, skip + 1);
+        if (size == 0) return {};
+        try {
+            std::shared_ptr<void*[]> frames(new void*[size]);
+            std::copy_n(buffer, size, frames.get());
+            return { std::move(frames), size };
+        } catch (std::bad_alloc const&) {
+            return {};
+        }
+    }
+
     // TODO: Add a logger argument here so we could better write out to a targetted buffer.
     // For now, we will stick to using the UtilsLogger.
     // It will be our caller's responsibility to determine what to do AFTER the backtrace is logged-- whether it be to terminate or rethrow.
     // Logs the backtrace with the Logging::ERROR level, using the global logger instance.
-    static void log_backtrace_full(void* const* stacktrace_buffer, uint16_t stacktrace_size) {
+    void exceptions::CapturedBacktrace::log(std::string_view header) const {
         auto const& logger = il2cpp_utils::Logger;
-        logger.error("[UNCAUGHT-EXCEPTION] Logging backtrace for RunMethodException with size: {}...", stacktrace_size);
+        if (!frames) {
+            logger.error("[UNCAUGHT-EXCEPTION] No backtrace was captured for {}, see SetBacktraceCapture", header);
+            return;
+        }
+        auto record = backtrace_helpers::recordBacktrace(frames.get(), size);
+        if (record.occurrences > 1) {
+            // Identical backtraces are only logged in full the first time they are seen
+            logger.error("[UNCAUGHT-EXCEPTION] Backtrace for {} is identical to trace {:016x}, seen {} times", header, record.hash, record.occurrences);
+            return;
+        }
+        logger.error("[UNCAUGHT-EXCEPTION] Logging backtrace for {} with size: {}, trace {:016x}...", header, size, record.hash);
         logger.error("[UNCAUGHT-EXCEPTION] *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** ***");
         logger.error("[UNCAUGHT-EXCEPTION] pid: {}, tid: {}", getpid(), gettid());
-        for (uint16_t i = 0; i < stacktrace_size; ++i) {
-            Dl_info info;
-            if (dladdr(stacktrace_buffer[i], &info)) {
-                // Buffer points to 1 instruction ahead
-                long addr = reinterpret_cast<char*>(stacktrace_buffer[i]) - reinterpret_cast<char*>(info.dli_fbase) - 4;
-                if (info.dli_sname) {
-                    int status;
-                    const char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
-                    if (status) {
-                        demangled = info.dli_sname;
-                    }
-                    logger.error("        #{:02}  pc {:016x}  {} ({})\n", i, addr, info.dli_fname, demangled);
-                    if (!status) {
-                        free(const_cast<char*>(demangled));
-                    }
-                } else {
-                    logger.error("        #{:02}  pc {:016x} {}\n", i, addr, info.dli_fname);
-                }
+        for (uint16_t i = 0; i < size; ++i) {
+            auto const& info = backtrace_helpers::symbolize(frames[i]);
+            if (!info.module) {
+                logger.error("        #{:02}  pc {:016x}  <unknown>", i, reinterpret_cast<uintptr_t>(frames[i]));
+                continue;
+            }
+            // Buffer points to 1 instruction ahead
+            auto addr = info.offset - 4;
+            if (!info.symbol.empty()) {
+                logger.error("        #{:02}  pc {:016x}  {} ({}+{}) (BuildId: {})", i, addr, info.module, info.symbol, info.symbolOffset - 4, info.buildId);
+            } else {
+                logger.error("        #{:02}  pc {:016x}  {} (BuildId: {})", i, addr, info.module, info.buildId);
             }
         }
     }
 
     void exceptions::StackTraceException::log_backtrace() const {
-        log_backtrace_full(stacktrace_buffer, stacktrace_size);
+        stacktrace.log("StackTraceException");
     }
 
     void RunMethodException::log_backtrace() const {
-        log_backtrace_full(stacktrace_buffer, stacktrace_size);
+        stacktrace.log("RunMethodException");
+    }
+
+    [[noreturn]] void HandleUncaughtException(char const* modId, bool translate) {
+        auto const& logger = il2cpp_utils::Logger;
+        try {
+            throw;
+        } catch (RunMethodException const& exc) {
+            logger.error("Caught in mod ID: {}: Uncaught RunMethodException! what(): {}", modId, exc.what());
+            exc.log_backtrace();
+            logger.error("Catch handler backtrace...");
+            logger.Backtrace(100);
+            if (translate && exc.ex) {
+                exc.rethrow();
+            }
+            SAFE_ABORT();
+        } catch (exceptions::StackTraceException const& exc) {
+            logger.error("Caught in mod ID: {}: Uncaught StackTraceException! what(): {}", modId, exc.what());
+            exc.log_backtrace();
+            logger.error("Catch handler backtrace...");
+            logger.Backtrace(100);
+            SAFE_ABORT();
+        } catch (std::exception const& exc) {
+            logger.error("Caught in mod ID: {}: Uncaught C++ exception! type name: {}, what(): {}", modId, typeid(exc).name(), exc.what());
+            logger.error("Catch handler backtrace...");
+            logger.Backtrace(100);
+            if (translate) {
+                il2cpp_utils::raise(exc);
+            }
+            SAFE_ABORT();
+        } catch (...) {
+            logger.error("Caught in mod ID: {}: Uncaught, unknown C++ exception (not std::exception) with no known what() method!", modId);
+            logger.error("Catch handler backtrace...");
+            logger.Backtrace(100);
+            SAFE_ABORT();
+        }
     }
 }
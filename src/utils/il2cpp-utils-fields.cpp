@@ -1,39 +1,57 @@
 #include "../../shared/utils/typedefs.h"
 #include "../../shared/utils/il2cpp-utils-fields.hpp"
 #include "../../shared/utils/hashing.hpp"
+#include "../../shared/utils/lookup-cache.hpp"
+#include "../../shared/utils/il2cpp-utils-members.hpp"
 #include "../../shared/utils/utils.h"
 #include <unordered_map>
 
 namespace il2cpp_utils {
-    static std::unordered_map<std::pair<const Il2CppClass*, std::string>, FieldInfo*, hash_pair> classesNamesToFieldsCache;
+    static std::unordered_map<std::pair<const Il2CppClass*, hashed_string>, lookup_entry<FieldInfo*>, hash_pair, equal_pair> classesNamesToFieldsCache;
     static std::mutex nameFieldLock;
 
-    FieldInfo* FindField(Il2CppClass* klass, std::string_view fieldName) {
+    static FieldInfo* FindField(Il2CppClass* klass, std::string_view fieldName, bool logMisses) {
         auto const& logger = il2cpp_utils::Logger;
         il2cpp_functions::Init();
-        RET_0_UNLESS(logger, klass);
+        if (!klass) {
+            if (logMisses) logger.error("FindField: klass is null!");
+            return nullptr;
+        }
 
-        // Check Cache
-        auto key = std::pair<Il2CppClass*, std::string>(klass, fieldName);
+        // Check Cache, including misses which have not expired yet
+        auto key = std::pair<const Il2CppClass*, hashed_string_view>(klass, fieldName);
         nameFieldLock.lock();
         auto itr = classesNamesToFieldsCache.find(key);
-        if (itr != classesNamesToFieldsCache.end()) {
+        if (itr != classesNamesToFieldsCache.end() && itr->second.valid(logMisses)) {
             nameFieldLock.unlock();
-            return itr->second;
+            return itr->second.value;
         }
         nameFieldLock.unlock();
-        auto field = il2cpp_functions::class_get_field_from_name(klass, fieldName.data());
-        if (!field) {
+        // The member index includes the fields of parents
+        auto field = GetMemberIndex(klass).FindField(fieldName);
+        if (!field && logMisses) {
             logger.error("could not find field {} in class '{}'!", fieldName.data(), ClassStandardName(klass).c_str());
-            LogFields(logger, klass);
-            if (klass->parent != klass) field = FindField(klass->parent, fieldName);
+            if (ShouldDumpLookupMiss(klass, 'f')) LogFields(logger, klass, true);
         }
         nameFieldLock.lock();
-        classesNamesToFieldsCache.emplace(key, field);
+        classesNamesToFieldsCache.insert_or_assign(std::pair<const Il2CppClass*, hashed_string>(key.first, key.second), make_lookup_entry(field, logMisses));
         nameFieldLock.unlock();
         return field;
     }
 
+    FieldInfo* FindField(Il2CppClass* klass, std::string_view fieldName) {
+        return FindField(klass, fieldName, true);
+    }
+
+    FieldInfo* TryFindField(Il2CppClass* klass, std::string_view fieldName) {
+        return FindField(klass, fieldName, false);
+    }
+
+    hash_table_stats GetFieldCacheStats() {
+        std::lock_guard lock(nameFieldLock);
+        return get_hash_stats(classesNamesToFieldsCache);
+    }
+
     Il2CppClass* GetFieldClass(FieldInfo* field) {
         auto const& logger = il2cpp_utils::Logger;
         auto type = RET_0_UNLESS(logger, il2cpp_functions::field_get_type(field));
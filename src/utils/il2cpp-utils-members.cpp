@@ -0,0 +1,92 @@
+#include "../../shared/utils/typedefs.h"
+#include "../../shared/utils/il2cpp-utils-members.hpp"
+#include "../../shared/utils/hashing.hpp"
+#include "../../shared/utils/utils.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace il2cpp_utils {
+    static std::unordered_map<const Il2CppClass*, std::unique_ptr<ClassMemberIndex const>> classesToMemberIndices;
+    static std::shared_mutex memberIndicesLock;
+
+    static void AddMethod(std::vector<const MethodInfo*>& overloads, const MethodInfo* method) {
+        if (std::find(overloads.begin(), overloads.end(), method) == overloads.end()) {
+            overloads.push_back(method);
+        }
+    }
+
+    static void IndexInterfaceMethods(ClassMemberIndex& index, Il2CppClass* klass, Il2CppClass* iface, int32_t offset) {
+        if (!iface->initialized_and_no_error) {
+            il2cpp_functions::Class_Init(iface);
+        }
+        void* iter = nullptr;
+        while (auto* method = il2cpp_functions::class_get_methods(iface, &iter)) {
+            // Only the implementation in klass can be called, whose name differs for explicit implementations (ex: System.IDisposable.Dispose)
+            if (method->slot == kInvalidIl2CppMethodSlot || offset + method->slot >= klass->vtable_count) continue;
+            auto const* impl = klass->vtable[offset + method->slot].method;
+            if (!impl || !impl->methodPointer) continue;
+            // Implicit implementations are already found through methods
+            auto itr = index.methods.find(method->name);
+            if (itr != index.methods.end() && std::find(itr->second.begin(), itr->second.end(), impl) != itr->second.end()) continue;
+            AddMethod(index.interfaceMethods[method->name], impl);
+        }
+    }
+
+    static std::unique_ptr<ClassMemberIndex> BuildMemberIndex(Il2CppClass* klass) {
+        auto index = std::make_unique<ClassMemberIndex>();
+        for (auto* current = klass; current; current = current->parent) {
+            if (!current->initialized_and_no_error) {
+                il2cpp_functions::Class_Init(current);
+            }
+            void* iter = nullptr;
+            while (auto* method = il2cpp_functions::class_get_methods(current, &iter)) {
+                AddMethod(index->methods[method->name], method);
+            }
+            iter = nullptr;
+            while (auto* field = il2cpp_functions::class_get_fields(current, &iter)) {
+                index->fields.try_emplace(field->name, field);
+            }
+            iter = nullptr;
+            while (auto* prop = il2cpp_functions::class_get_properties(current, &iter)) {
+                index->properties.try_emplace(prop->name, prop);
+            }
+            if (current->parent == current) break;
+        }
+
+        // Interfaces have no vtable to resolve through, so only classes get implementations of interface methods.
+        // interfaceOffsets covers the interfaces implemented by parents as well.
+        if (!il2cpp_functions::class_is_interface(klass)) {
+            for (uint16_t i = 0; i < klass->interface_offsets_count; i++) {
+                auto const& pair = klass->interfaceOffsets[i];
+                IndexInterfaceMethods(*index, klass, pair.interfaceType, pair.offset);
+            }
+        }
+        return index;
+    }
+
+    ClassMemberIndex const& GetMemberIndex(Il2CppClass* klass) {
+        il2cpp_functions::Init();
+        auto const& logger = il2cpp_utils::Logger;
+        CRASH_UNLESS(klass);
+        {
+            std::shared_lock lock(memberIndicesLock);
+            auto itr = classesToMemberIndices.find(klass);
+            if (itr != classesToMemberIndices.end()) {
+                return *itr->second;
+            }
+        }
+        // Build outside of the lock, a concurrent build of the same class is discarded
+        auto index = BuildMemberIndex(klass);
+        logger.debug("Indexed {} method names, {} interface method names, {} fields and {} properties of class {}", index->methods.size(), index->interfaceMethods.size(), index->fields.size(), index->properties.size(), fmt::ptr(klass));
+        std::unique_lock lock(memberIndicesLock);
+        return *classesToMemberIndices.try_emplace(klass, std::move(index)).first->second;
+    }
+
+    hash_table_stats GetMemberIndexStats() {
+        std::shared_lock lock(memberIndicesLock);
+        return get_hash_stats(classesToMemberIndices);
+    }
+}
@@ -1,6 +1,8 @@
 #include "../../shared/utils/typedefs.h"
 #include "../../shared/utils/il2cpp-utils-methods.hpp"
 #include "../../shared/utils/hashing.hpp"
+#include "../../shared/utils/lookup-cache.hpp"
+#include "../../shared/utils/il2cpp-utils-members.hpp"
 #include "utils/il2cpp-functions.hpp"
 #include "utils/il2cpp-utils-classes.hpp"
 #include "utils/il2cpp-utils-methods.hpp"
@@ -17,7 +19,7 @@
 namespace std {
     // From https://www.boost.org/doc/libs/1_55_0/doc/html/hash/reference.html#boost.hash_combine
     template<class T> void hash_combine(size_t& seed, T v) {
-        seed ^= std::hash<T>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed = il2cpp_utils::hash_combine(seed, std::hash<T>{}(v));
     }
 
     // Let a "sequence" type be any type that supports .size() and iteration and whose elements are hashable and support !=.
@@ -46,13 +48,11 @@ namespace std {
     template <>
     struct hash<il2cpp_utils::FindMethodInfo> {
         std::size_t operator()(il2cpp_utils::FindMethodInfo const& info) const noexcept {
-            auto hashPtr = std::hash<void*>{};
-            auto hashSize = std::hash<std::size_t>{};
-
-            auto hashStr = std::hash<std::string_view>{};
-
-            return hashPtr(info.klass) ^  // hashPtr(info.returnType) ^
-                   hashStr(info.name) ^ hashSize(info.argTypes.size()) ^ hashSize(info.genTypes.size());
+            std::size_t seed = std::hash<void*>{}(info.klass);
+            hash_combine(seed, std::string_view(info.name));
+            seed = il2cpp_utils::hash_combine(seed, hash_seq(info.argTypes));
+            seed = il2cpp_utils::hash_combine(seed, hash_seq(info.genTypes));
+            return seed;
         }
     };
 }
@@ -60,11 +60,16 @@ namespace std {
 
 namespace il2cpp_utils {
     typedef std::pair<std::string, std::vector<const Il2CppType*>> classesNamesTypesInnerPairType;
-    static std::unordered_map<std::pair<const Il2CppClass*, std::pair<std::string, decltype(MethodInfo::parameters_count)>>, const MethodInfo*, hash_pair_3> classesNamesToMethodsCache;
-    static std::unordered_map<FindMethodInfo, const MethodInfo*> classesNamesTypesToMethodsCache;
+    static std::unordered_map<std::pair<const Il2CppClass*, std::pair<hashed_string, decltype(MethodInfo::parameters_count)>>, lookup_entry<const MethodInfo*>, hash_pair_3, equal_pair> classesNamesToMethodsCache;
+    static std::unordered_map<FindMethodInfo, lookup_entry<const MethodInfo*>> classesNamesTypesToMethodsCache;
     std::mutex classNamesMethodsLock;
     std::shared_mutex classTypesMethodsLock;
 
+    hash_table_stats GetMethodCacheStats() {
+        std::lock_guard lock(classNamesMethodsLock);
+        return get_hash_stats(classesNamesToMethodsCache);
+    }
+
 
 
 #if __has_feature(cxx_exceptions)
@@ -198,39 +203,59 @@ namespace il2cpp_utils {
         return ResolveVtableSlot(klass, GetClassFromName(declaringNamespace, declaringClassName), slot);
     }
 
-    #if __has_feature(cxx_exceptions)
-    const MethodInfo* FindMethodUnsafe(const Il2CppClass* klass, std::string_view methodName, int argsCount)
-    #else
-    const MethodInfo* FindMethodUnsafe(const Il2CppClass* klass, std::string_view methodName, int argsCount) noexcept
-    #endif
-    {
+    static const MethodInfo* FindMethodUnsafe(const Il2CppClass* klass, std::string_view methodName, int argsCount, bool logMisses) {
         il2cpp_functions::Init();
         auto const& logger = il2cpp_utils::Logger;
-        RET_DEFAULT_UNLESS(logger, klass);
+        if (!klass) {
+            if (logMisses) logger.error("FindMethodUnsafe: klass is null!");
+            return nullptr;
+        }
 
-        // Check Cache
-        auto innerPair = std::pair<std::string, decltype(MethodInfo::parameters_count)>(methodName, argsCount);
+        // Check Cache, including misses which have not expired yet
+        auto innerPair = std::pair<hashed_string_view, decltype(MethodInfo::parameters_count)>(methodName, argsCount);
         auto key = std::pair<const Il2CppClass*, decltype(innerPair)>(klass, innerPair);
         classNamesMethodsLock.lock();
         auto itr = classesNamesToMethodsCache.find(key);
-        if (itr != classesNamesToMethodsCache.end()) {
+        if (itr != classesNamesToMethodsCache.end() && itr->second.valid(logMisses)) {
             classNamesMethodsLock.unlock();
-            return itr->second;
+            return itr->second.value;
         }
         classNamesMethodsLock.unlock();
-        // Recurses through klass's parents
-        auto methodInfo = il2cpp_functions::class_get_method_from_name(klass, methodName.data(), argsCount);
-        if (!methodInfo) {
+        // The member index includes the methods of parents in resolution order, and interface implementations after them
+        const MethodInfo* methodInfo = nullptr;
+        auto const& index = GetMemberIndex(const_cast<Il2CppClass*>(klass));
+        for (auto candidates : { index.FindMethods(methodName), index.FindInterfaceMethods(methodName) }) {
+            for (auto const* method : candidates) {
+                if (argsCount == -1 || method->parameters_count == argsCount) {
+                    methodInfo = method;
+                    break;
+                }
+            }
+            if (methodInfo) break;
+        }
+        if (!methodInfo && logMisses) {
             logger.error("could not find method {} with {} parameters in class '{}'!", methodName.data(), argsCount, ClassStandardName(klass).c_str());
-            LogMethods(logger, const_cast<Il2CppClass*>(klass), true);
-            RET_DEFAULT_UNLESS(logger, methodInfo);
+            if (ShouldDumpLookupMiss(klass, 'm')) LogMethods(logger, const_cast<Il2CppClass*>(klass), true);
         }
         classNamesMethodsLock.lock();
-        classesNamesToMethodsCache.emplace(key, methodInfo);
+        classesNamesToMethodsCache.insert_or_assign(std::pair(key.first, std::pair<hashed_string, decltype(MethodInfo::parameters_count)>(innerPair)), make_lookup_entry(methodInfo, logMisses));
         classNamesMethodsLock.unlock();
         return methodInfo;
     }
 
+    #if __has_feature(cxx_exceptions)
+    const MethodInfo* FindMethodUnsafe(const Il2CppClass* klass, std::string_view methodName, int argsCount)
+    #else
+    const MethodInfo* FindMethodUnsafe(const Il2CppClass* klass, std::string_view methodName, int argsCount) noexcept
+    #endif
+    {
+        return FindMethodUnsafe(klass, methodName, argsCount, true);
+    }
+
+    const MethodInfo* TryFindMethodUnsafe(const Il2CppClass* klass, std::string_view methodName, int argsCount) {
+        return FindMethodUnsafe(klass, methodName, argsCount, false);
+    }
+
     #if __has_feature(cxx_exceptions)
     const MethodInfo* FindMethodUnsafe(std::string_view nameSpace, std::string_view className, std::string_view methodName, int argsCount)
     #else
@@ -355,23 +380,21 @@ namespace il2cpp_utils {
         return distance;
     }
 
-#if __has_feature(cxx_exceptions)
-    const MethodInfo* FindMethod(FindMethodInfo&& info)
-#else
-    const MethodInfo* FindMethod(FindMethodInfo&& info) noexcept
-#endif
-    {
+    static const MethodInfo* FindMethod(FindMethodInfo&& info, bool logMisses) {
         auto logger = il2cpp_utils::Logger;
         il2cpp_functions::Init();
         auto* klass = info.klass;
-        RET_DEFAULT_UNLESS(logger, klass);
+        if (!klass) {
+            if (logMisses) logger.error("FindMethod: klass is null!");
+            return nullptr;
+        }
 
-        // Check Cache
+        // Check Cache, including misses which have not expired yet
         {
             std::shared_lock lock(classTypesMethodsLock);
             auto itr = classesNamesTypesToMethodsCache.find(info);
-            if (itr != classesNamesTypesToMethodsCache.end()) {
-                return itr->second;
+            if (itr != classesNamesTypesToMethodsCache.end() && itr->second.valid(logMisses)) {
+                return itr->second.value;
             }
         }
 
@@ -397,19 +420,8 @@ namespace il2cpp_utils {
 
         const MethodInfo* target = nullptr;
 
-        auto addMethodsToMatches = [&](Il2CppClass* targetKlass) {
-            // initialize klass if needed
-            if (!targetKlass->initialized_and_no_error) {
-                il2cpp_functions::Class_Init(targetKlass);
-            }
-            // Does NOT automatically recurse through klass's parents
-            auto const methodsSpan = std::span(targetKlass->methods, targetKlass->method_count);
-            for (auto const& current : methodsSpan) {
-                if (info.name != current->name) {
-                    // logger.debug("Method name does not match for method %s", current->name);
-                    continue;
-                }
-
+        auto addMethodsToMatches = [&](std::span<const MethodInfo* const> candidates) {
+            for (auto const* current : candidates) {
                 // strict equal
                 bool isPerfect;
                 if (!ParameterMatch(current, std::span(info.genTypes), std::span(info.argTypes), &isPerfect)) {
@@ -423,18 +435,16 @@ namespace il2cpp_utils {
                     break;
                 }
 
-                auto methodParams = std::span(current->parameters, current->parameters_count);
-
                 matches.push_back(current);
             }
         };
 
-        // now look for matches recursively
-        auto targetKlass = info.klass;
-        // if we reached no parent or perfect target is found, we're done
-        while (targetKlass != nullptr && target == nullptr) {
-            addMethodsToMatches(targetKlass);
-            targetKlass = targetKlass->parent;
+        // The member index holds every method named info.name on klass and its parents, in resolution order
+        auto const& index = GetMemberIndex(klass);
+        addMethodsToMatches(index.FindMethods(info.name));
+        // Interface implementations only count when klass and its parents have no candidate, so they never make overloads ambiguous
+        if (!target && matches.empty()) {
+            addMethodsToMatches(index.FindInterfaceMethods(info.name));
         }
 
         // Method overload resolution
@@ -487,7 +497,7 @@ namespace il2cpp_utils {
             }
         }
 
-        if (!target) {
+        if (!target && logMisses) {
             std::stringstream ss;
             ss << ((matches.size() > 1) ? "found multiple matches for" : "could not find");
             ss << " method " << info.name;
@@ -513,18 +523,31 @@ namespace il2cpp_utils {
             }
             ss << ") in class '" << ClassStandardName(klass) << "'!";
             logger.error("{}", ss.str().c_str());
-            LogMethods(logger, klass);
+            if (ShouldDumpLookupMiss(klass, 'm')) LogMethods(logger, klass);
         }
 
         // add to cache
         {
             std::unique_lock lock(classTypesMethodsLock);
-            classesNamesTypesToMethodsCache.emplace(std::move(info), target);
+            classesNamesTypesToMethodsCache.insert_or_assign(std::move(info), make_lookup_entry(target, logMisses));
         }
 
         return target;
     }
 
+#if __has_feature(cxx_exceptions)
+    const MethodInfo* FindMethod(FindMethodInfo&& info)
+#else
+    const MethodInfo* FindMethod(FindMethodInfo&& info) noexcept
+#endif
+    {
+        return FindMethod(std::move(info), true);
+    }
+
+    const MethodInfo* TryFindMethod(FindMethodInfo&& info) {
+        return FindMethod(std::move(info), false);
+    }
+
     void LogMethods(Paper::LoggerContext const& logger, Il2CppClass const* klass, bool logParents) {
         RET_V_UNLESS(logger, klass);
 
@@ -3,38 +3,56 @@
 #include "../../shared/utils/utils.h"
 #include <unordered_map>
 #include "../../shared/utils/hashing.hpp"
+#include "../../shared/utils/lookup-cache.hpp"
+#include "../../shared/utils/il2cpp-utils-members.hpp"
 
 namespace il2cpp_utils {
-    static std::unordered_map<std::pair<const Il2CppClass*, std::string>, const PropertyInfo*, hash_pair> classesNamesToPropertiesCache;
+    static std::unordered_map<std::pair<const Il2CppClass*, hashed_string>, lookup_entry<const PropertyInfo*>, hash_pair, equal_pair> classesNamesToPropertiesCache;
     static std::mutex classPropertiesLock;
 
-    const PropertyInfo* FindProperty(Il2CppClass* klass, std::string_view propName) {
+    static const PropertyInfo* FindProperty(Il2CppClass* klass, std::string_view propName, bool logMisses) {
         auto const& logger = il2cpp_utils::Logger;
 
         il2cpp_functions::Init();
-        RET_0_UNLESS(logger, klass);
+        if (!klass) {
+            if (logMisses) logger.error("FindProperty: klass is null!");
+            return nullptr;
+        }
 
-        // Check Cache
-        auto key = std::pair<Il2CppClass*, std::string>(klass, propName);
+        // Check Cache, including misses which have not expired yet
+        auto key = std::pair<const Il2CppClass*, hashed_string_view>(klass, propName);
         classPropertiesLock.lock();
         auto itr = classesNamesToPropertiesCache.find(key);
-        if (itr != classesNamesToPropertiesCache.end()) {
+        if (itr != classesNamesToPropertiesCache.end() && itr->second.valid(logMisses)) {
             classPropertiesLock.unlock();
-            return itr->second;
+            return itr->second.value;
         }
         classPropertiesLock.unlock();
-        auto prop = il2cpp_functions::class_get_property_from_name(klass, propName.data());
-        if (!prop) {
+        // The member index includes the properties of parents
+        auto prop = GetMemberIndex(klass).FindProperty(propName);
+        if (!prop && logMisses) {
             logger.error("could not find property {} in class '{}'!", propName.data(), ClassStandardName(klass).c_str());
-            LogProperties(logger, klass);
-            if (klass->parent != klass) prop = FindProperty(klass->parent, propName);
+            if (ShouldDumpLookupMiss(klass, 'p')) LogProperties(logger, klass, true);
         }
         classPropertiesLock.lock();
-        classesNamesToPropertiesCache.emplace(key, prop);
+        classesNamesToPropertiesCache.insert_or_assign(std::pair<const Il2CppClass*, hashed_string>(key.first, key.second), make_lookup_entry(prop, logMisses));
         classPropertiesLock.unlock();
         return prop;
     }
 
+    const PropertyInfo* FindProperty(Il2CppClass* klass, std::string_view propName) {
+        return FindProperty(klass, propName, true);
+    }
+
+    const PropertyInfo* TryFindProperty(Il2CppClass* klass, std::string_view propName) {
+        return FindProperty(klass, propName, false);
+    }
+
+    hash_table_stats GetPropertyCacheStats() {
+        std::lock_guard lock(classPropertiesLock);
+        return get_hash_stats(classesNamesToPropertiesCache);
+    }
+
     const PropertyInfo* FindProperty(std::string_view nameSpace, std::string_view className, std::string_view propertyName) {
         return FindProperty(GetClassFromName(nameSpace, className), propertyName);
     }
@@ -0,0 +1,123 @@
+#include "../../shared/utils/typedefs.h"
+#include "../../shared/utils/il2cpp-utils-warmup.hpp"
+#include "../../shared/utils/il2cpp-utils.hpp"
+#include "../../shared/utils/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace il2cpp_utils {
+    namespace {
+        struct WarmUpEntry {
+            std::string label;
+            InlineFunction<bool()> resolve;
+            bool resolved = false;
+        };
+
+        // Function local, so that registrations from other translation units' static initializers find it constructed
+        // A deque, so entries stay in place while lookups register more
+        std::deque<WarmUpEntry>& WarmUpRegistry() {
+            static std::deque<WarmUpEntry> registry;
+            return registry;
+        }
+        std::mutex& WarmUpRegistryLock() {
+            static std::mutex lock;
+            return lock;
+        }
+    }
+
+    void RegisterWarmUp(std::string_view label, InlineFunction<bool()> resolve) {
+        std::lock_guard lock(WarmUpRegistryLock());
+        WarmUpRegistry().push_back({ std::string(label), std::move(resolve) });
+    }
+
+    void RegisterWarmUpClass(std::string_view nameSpace, std::string_view className) {
+        RegisterWarmUp(std::string(nameSpace) + "::" + std::string(className), [nameSpace = std::string(nameSpace), className = std::string(className)]() {
+            return GetClassFromName(nameSpace, className) != nullptr;
+        });
+    }
+
+    void RegisterWarmUpMethod(std::string_view nameSpace, std::string_view className, std::string_view methodName, int argsCount) {
+        auto label = std::string(nameSpace) + "::" + std::string(className) + "::" + std::string(methodName);
+        RegisterWarmUp(label, [nameSpace = std::string(nameSpace), className = std::string(className), methodName = std::string(methodName), argsCount]() {
+            return TryFindMethodUnsafe(GetClassFromName(nameSpace, className), methodName, argsCount) != nullptr;
+        });
+    }
+
+    WarmUpStats WarmUp(std::size_t threadCount, InlineFunction<void(std::size_t, std::size_t)> progress) {
+        auto const& logger = il2cpp_utils::Logger;
+        il2cpp_functions::Init();
+        static std::mutex warmUpLock;
+        std::lock_guard warmUpGuard(warmUpLock);
+        auto start = std::chrono::steady_clock::now();
+
+        // Entries registered while warming up are left for the next call
+        std::unique_lock registryLock(WarmUpRegistryLock());
+        auto& registry = WarmUpRegistry();
+        std::vector<WarmUpEntry*> pending;
+        for (auto& entry : registry) {
+            if (!entry.resolved) pending.push_back(&entry);
+        }
+        registryLock.unlock();
+
+        WarmUpStats stats;
+        if (pending.empty()) return stats;
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        stats.threads = threadCount = std::min(threadCount, pending.size());
+
+        std::atomic_size_t next = 0;
+        std::atomic_size_t done = 0;
+        std::mutex statsLock;
+        auto work = [&]() {
+            // Lookups may run managed code (ex: static constructors), so the thread must be known to il2cpp
+            auto* thread = il2cpp_functions::thread_attach(il2cpp_functions::domain_get());
+            for (auto i = next++; i < pending.size(); i = next++) {
+                auto* entry = pending[i];
+                auto entryStart = std::chrono::steady_clock::now();
+                bool ok = false;
+                try {
+                    ok = entry->resolve();
+                } catch (std::exception const& e) {
+                    logger.error("WarmUp: resolving {} threw: {}", entry->label, e.what());
+                } catch (...) {
+                    logger.error("WarmUp: resolving {} threw!", entry->label);
+                }
+                auto took = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - entryStart);
+                {
+                    std::lock_guard lock(statsLock);
+                    entry->resolved = ok;
+                    (ok ? stats.resolved : stats.failed)++;
+                    stats.busy += took;
+                    if (took > stats.slowest) {
+                        stats.slowest = took;
+                        stats.slowestLabel = entry->label;
+                    }
+                }
+                if (!ok) logger.warn("WarmUp: could not resolve {}", entry->label);
+                auto count = ++done;
+                if (progress) progress(count, pending.size());
+            }
+            il2cpp_functions::thread_detach(thread);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; i++) {
+            threads.emplace_back(work);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        logger.info("WarmUp: resolved {} lookups ({} failed) on {} threads in {}us ({}us of lookups), slowest: {} in {}us",
+            stats.resolved, stats.failed, stats.threads, stats.elapsed.count(), stats.busy.count(), stats.slowestLabel, stats.slowest.count());
+        return stats;
+    }
+}
@@ -7,7 +7,13 @@
 #include "../../shared/utils/il2cpp-functions.hpp"
 #include "utils/il2cpp-utils-methods.hpp"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <sstream>
@@ -179,6 +185,25 @@ namespace il2cpp_utils {
         return ss.str();
     }
 
+    namespace {
+        // Runs the static constructor of klass if it has not run yet, through il2cpp's own type initialization.
+        // That waits for a cctor another thread is running, and lets the thread running it re-enter, as in C#.
+        // Returns an error message on failure.
+        std::optional<std::string> RunClassConstructorOnce(Il2CppClass* klass) {
+            // Once finished the flag never changes again, so this is all that is needed after the first instance
+            if (!klass->has_cctor || klass->cctor_finished_or_no_cctor) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return std::nullopt;
+            }
+            try {
+                il2cpp_functions::runtime_class_init(klass);
+            } catch (Il2CppExceptionWrapper& wrapper) {
+                return fmt::format("Type initializer of {} failed: {}", ClassStandardName(klass), ExceptionToString(wrapper.ex));
+            }
+            return std::nullopt;
+        }
+    }  // namespace
+
     Il2CppObject* createManual(const Il2CppClass* klass) noexcept {
         auto const& logger = il2cpp_utils::Logger;
         if (!klass) {
@@ -196,11 +221,10 @@ namespace il2cpp_utils {
         }
         obj->klass = const_cast<Il2CppClass*>(klass);
         // Call cctor, we don't bother making a new thread for the type initializer. BE WARNED!
-        if (klass->has_cctor && !klass->cctor_finished_or_no_cctor && !klass->cctor_started) {
-            obj->klass->cctor_started = true;
-            auto* m = RET_0_UNLESS(logger, FindMethodUnsafe(klass, ".cctor", 0));
-            RET_0_UNLESS(logger, il2cpp_utils::RunMethodOpt(nullptr, m));
-            obj->klass->cctor_finished_or_no_cctor = true;
+        if (auto error = RunClassConstructorOnce(obj->klass)) {
+            logger.error("{}", *error);
+            gc_free_specific(obj);
+            return nullptr;
         }
         return obj;
     }
@@ -215,35 +239,67 @@ namespace il2cpp_utils {
         }
         obj->klass = const_cast<Il2CppClass*>(klass);
         // Call cctor, we don't bother making a new thread for the type initializer. BE WARNED!
-        if (klass->has_cctor && !klass->cctor_finished_or_no_cctor && !klass->cctor_started) {
-            obj->klass->cctor_started = true;
-            auto* m = FindMethodUnsafe(klass, ".cctor", 0);
-            if (!m) {
-                throw exceptions::StackTraceException("Failed to find .cctor method!");
-            }
-            if (!il2cpp_utils::RunMethodOpt(nullptr, m)) {
-                throw exceptions::StackTraceException("Failed to run .cctor method!");
-            }
-            obj->klass->cctor_finished_or_no_cctor = true;
+        if (auto error = RunClassConstructorOnce(klass)) {
+            gc_free_specific(obj);
+            throw exceptions::StackTraceException(*error);
         }
         return obj;
     }
 
-    void* __AllocateUnsafe(std::size_t size) {
+    namespace {
+        // Sizes up to 64 round up to 16 bytes, larger ones to a quarter of their power of two,
+        // so an object is at most a quarter larger than requested and sizes up to MAX_SIZED share 104 classes.
+        constexpr std::size_t MAX_SIZED = std::size_t(1) << 31;
+        constexpr std::size_t SIZED_CLASS_COUNT = 104;
+
+        std::size_t RoundSizedClass(std::size_t size, std::size_t& index) {
+            if (size <= 64) {
+                size = std::max<std::size_t>((size + 15) & ~std::size_t(15), 16);
+                index = size / 16 - 1;
+                return size;
+            }
+            // size is in (2^(width - 1), 2^width], split into 4 steps of 2^(width - 3)
+            auto const shift = std::bit_width(size - 1) - 3;
+            auto const step = std::size_t(1) << shift;
+            size = (size + step - 1) & ~(step - 1);
+            index = 4 + (shift - 4) * 4 + (size >> shift) - 5;
+            return size;
+        }
+    }
+
+    void* AllocateSized(std::size_t size) {
         il2cpp_functions::Init();
-        // Because we want to allocate this object using C# GC, we will do a bit of a hack here.
-        // Essentially, we take advantage of the instance size of System.Object, and then IMMEDIATELY revert it.
-        // If we fail for ANY REASON in here, VERY BAD THINGS can happen.
         static auto* objKlass = CRASH_UNLESS(il2cpp_functions::defaults->object_class);
-        // Ideally, we make this atomic, but because we aren't using locks anywhere, we hope for the best...
-        // TODO: Acquire object class special lock
-        auto origSize = objKlass->instance_size;
-        objKlass->instance_size = static_cast<decltype(origSize)>(size);
-        auto* instance = il2cpp_functions::object_new(objKlass);
-        objKlass->instance_size = origSize;
+        // object_new takes the size from the class, so allocate with a private copy of System.Object per size class.
+        // The copies are never modified once published, so any number of threads can allocate with them at once.
+        // There is a bounded number of size classes, so at most SIZED_CLASS_COUNT copies are ever made.
+        static std::mutex sizedMutex;
+        static std::array<std::atomic<Il2CppClass*>, SIZED_CLASS_COUNT> sizedClasses{};
+        CRASH_UNLESS(size <= MAX_SIZED);
+        std::size_t index;
+        size = RoundSizedClass(std::max<std::size_t>(size, objKlass->instance_size), index);
+        auto* sized = sizedClasses[index].load(std::memory_order_acquire);
+        if (!sized) {
+            std::lock_guard lock(sizedMutex);
+            sized = sizedClasses[index].load(std::memory_order_relaxed);
+            if (!sized) {
+                auto classSize = sizeof(Il2CppClass) + objKlass->vtable_count * sizeof(VirtualInvokeData);
+                sized = static_cast<Il2CppClass*>(CRASH_UNLESS(malloc(classSize)));
+                std::memcpy(sized, objKlass, classSize);
+                sized->instance_size = static_cast<decltype(sized->instance_size)>(size);
+                sizedClasses[index].store(sized, std::memory_order_release);
+            }
+        }
+        auto* instance = CRASH_UNLESS(il2cpp_functions::object_new(sized));
+        // The instance is a System.Object as far as anything else is concerned
+        instance->klass = objKlass;
         return instance;
     }
 
+    void* __AllocateUnsafe(std::size_t size) {
+        return AllocateSized(size);
+    }
+
     [[nodiscard]] bool Match(const Il2CppObject* source, const Il2CppClass* klass) noexcept {
         return (source->klass == klass);
     }
@@ -259,25 +315,174 @@ namespace il2cpp_utils {
         return true;
     }
 
+    void LogCacheStats(Paper::LoggerContext const& logger) {
+        auto log = [&logger](std::string_view name, hash_table_stats const& stats) {
+            logger.info("{}: {} entries in {} buckets ({} used), max bucket size {}, average probe length {:.3f}, {} hash collisions",
+                name, stats.size, stats.bucket_count, stats.used_buckets, stats.max_bucket_size, stats.average_probe_length, stats.hash_collisions);
+        };
+        log("classesNamesToPropertiesCache", GetPropertyCacheStats());
+        log("classesNamesToFieldsCache", GetFieldCacheStats());
+        log("classesNamesToMethodsCache", GetMethodCacheStats());
+        log("namesToClassesCache", GetClassNameCacheStats());
+        log("classesToMemberIndices", GetMemberIndexStats());
+    }
+
+    static std::atomic<std::chrono::milliseconds::rep> lookupMissExpiry = std::chrono::milliseconds(std::chrono::seconds(30)).count();
+
+    void SetLookupMissExpiry(std::chrono::milliseconds expiry) noexcept {
+        lookupMissExpiry.store(expiry.count(), std::memory_order_relaxed);
+    }
+
+    std::chrono::milliseconds GetLookupMissExpiry() noexcept {
+        return std::chrono::milliseconds(lookupMissExpiry.load(std::memory_order_relaxed));
+    }
+
+    // When each class was last dumped after a failed lookup, per kind of member
+    static std::unordered_map<std::pair<const Il2CppClass*, char>, lookup_clock::time_point, hash_pair> lookupMissDumps;
+    static std::mutex lookupMissDumpsLock;
+
+    bool ShouldDumpLookupMiss(const Il2CppClass* klass, char kind) noexcept {
+        auto now = lookup_clock::now();
+        std::lock_guard lock(lookupMissDumpsLock);
+        auto [itr, inserted] = lookupMissDumps.try_emplace({ klass, kind }, now);
+        if (inserted) return true;
+        if (now - itr->second < GetLookupMissExpiry()) return false;
+        itr->second = now;
+        return true;
+    }
+
     // Contains the map of created MethodInfo* instances
     std::unordered_map<std::pair<Il2CppMethodPointer, bool>, MethodInfo*> delegateMethodInfoMap;
+    std::shared_mutex delegateMethodInfoMutex;
+
+    namespace {
+        // MethodInfos handed out by GetDelegateMethodInfo, allocated in chunks.
+        // They are never reused once handed out, as that would alias caches keyed by MethodInfo* (ex: VerifiedMethods, FindMethod).
+        struct DelegateMethodPool {
+            static constexpr std::size_t chunkCount = 64;
+            MethodInfo* chunk = nullptr;
+            std::size_t used = chunkCount;
+
+            MethodInfo* take() {
+                if (used == chunkCount) {
+                    chunk = static_cast<MethodInfo*>(CRASH_UNLESS(calloc(chunkCount, sizeof(MethodInfo))));
+                    used = 0;
+                }
+                return chunk + used++;
+            }
+        };
+
+        struct TrackedDelegate {
+            // Weak handle to the delegate instance
+            uint32_t handle;
+            void* context;
+            void (*destroy)(void*);
+        };
+
+        // All guarded by delegateMethodInfoMutex
+        DelegateMethodPool delegatePool;
+        // MethodInfo*s which came from the pool rather than AddAllocatedDelegate
+        std::unordered_set<MethodInfo const*> pooledDelegateMethods;
+        std::vector<TrackedDelegate> trackedDelegates;
+        std::size_t collectThreshold = 256;
+
+        void ReleaseDelegate(MethodInfo* info) {
+            // Pooled MethodInfo*s may still be referenced by live delegates, so they are only forgotten
+            if (!pooledDelegateMethods.contains(info)) {
+                free(info);
+            }
+        }
+
+        // Removes the tracked delegates which have been collected, returning them so their contexts can be destroyed outside of the lock
+        std::vector<TrackedDelegate> CollectDelegatesLocked() {
+            std::vector<TrackedDelegate> dead;
+            std::erase_if(trackedDelegates, [&dead](TrackedDelegate const& tracked) {
+                if (il2cpp_functions::gchandle_get_target(tracked.handle)) return false;
+                il2cpp_functions::gchandle_free(tracked.handle);
+                dead.push_back(tracked);
+                return true;
+            });
+            return dead;
+        }
+
+        std::size_t DestroyContexts(std::vector<TrackedDelegate> const& dead) {
+            for (auto const& tracked : dead) {
+                if (tracked.destroy) tracked.destroy(tracked.context);
+            }
+            return dead.size();
+        }
+    }  // namespace
 
     void ClearDelegates() {
+        std::unique_lock lock(delegateMethodInfoMutex);
         for (auto itr : delegateMethodInfoMap) {
-            free(itr.second);
+            ReleaseDelegate(itr.second);
         }
         delegateMethodInfoMap.clear();
     }
 
     void ClearDelegate(std::pair<Il2CppMethodPointer, bool> delegate) {
+        std::unique_lock lock(delegateMethodInfoMutex);
         auto itr = delegateMethodInfoMap.find(delegate);
         if (itr != delegateMethodInfoMap.end()) {
-            free(itr->second);
+            ReleaseDelegate(itr->second);
             delegateMethodInfoMap.erase(itr);
         }
     }
 
     void AddAllocatedDelegate(std::pair<Il2CppMethodPointer, bool> delegate, MethodInfo* mptr) {
+        std::unique_lock lock(delegateMethodInfoMutex);
         delegateMethodInfoMap.insert({delegate, mptr});
     }
+
+    const MethodInfo* GetDelegateMethodInfo(std::pair<Il2CppMethodPointer, bool> delegate, const MethodInfo* invoke) {
+        {
+            std::shared_lock lock(delegateMethodInfoMutex);
+            auto itr = delegateMethodInfoMap.find(delegate);
+            if (itr != delegateMethodInfoMap.end()) {
+                return itr->second;
+            }
+        }
+        std::unique_lock lock(delegateMethodInfoMutex);
+        // Another thread may have created it between the two locks
+        auto [itr, inserted] = delegateMethodInfoMap.try_emplace(delegate, nullptr);
+        if (inserted) {
+            auto* info = delegatePool.take();
+            info->methodPointer = delegate.first;
+            info->invoker_method = nullptr;
+            info->return_type = invoke->return_type;
+            info->parameters = invoke->parameters;
+            info->parameters_count = invoke->parameters_count;
+            info->slot = kInvalidIl2CppMethodSlot;
+            info->flags = delegate.second ? METHOD_ATTRIBUTE_STATIC : 0;
+            info->is_marshaled_from_native = true;
+            pooledDelegateMethods.insert(info);
+            itr->second = info;
+        }
+        return itr->second;
+    }
+
+    void TrackDelegate(Il2CppDelegate* instance, void* context, void (*destroy)(void*)) {
+        il2cpp_functions::Init();
+        auto handle = il2cpp_functions::gchandle_new_weakref(reinterpret_cast<Il2CppObject*>(instance), false);
+        std::vector<TrackedDelegate> dead;
+        {
+            std::unique_lock lock(delegateMethodInfoMutex);
+            trackedDelegates.push_back({ handle, context, destroy });
+            // Sweep once enough delegates have been tracked since the last sweep, so this stays amortized constant time
+            if (trackedDelegates.size() >= collectThreshold) {
+                dead = CollectDelegatesLocked();
+                collectThreshold = std::max<std::size_t>(256, trackedDelegates.size() * 2);
+            }
+        }
+        DestroyContexts(dead);
+    }
+
+    std::size_t CollectDelegates() {
+        il2cpp_functions::Init();
+        std::unique_lock lock(delegateMethodInfoMutex);
+        auto dead = CollectDelegatesLocked();
+        lock.unlock();
+        return DestroyContexts(dead);
+    }
 }
@@ -9,6 +9,8 @@
 #include <iostream>
 #include <sstream>
 #include <unordered_set>
+#include <atomic>
+#include <iterator>
 #include <link.h>
 #include "il2cpp-object-internals.h"
 #include "shared/utils/gc-alloc.hpp"
@@ -37,6 +39,160 @@ size_t captureBacktrace(void** buffer, uint16_t max, uint16_t skip) {
 
     return state.current - buffer;
 }
+
+// Open addressed, insert only tables. Entries are immutable once published and are never freed, so readers never need to lock.
+static constexpr size_t SYMBOL_CACHE_SIZE = 1 << 14;
+static constexpr size_t MODULE_CACHE_SIZE = 1 << 9;
+static constexpr size_t TRACE_CACHE_SIZE = 1 << 10;
+
+struct ModuleEntry {
+    uintptr_t base;
+    std::string buildId;
+};
+
+struct TraceEntry {
+    std::atomic<uint64_t> hash;
+    std::atomic<uint32_t> count;
+};
+
+static std::atomic<SymbolInfo const*> symbolCache[SYMBOL_CACHE_SIZE];
+static std::atomic<ModuleEntry const*> moduleCache[MODULE_CACHE_SIZE];
+static TraceEntry traceCache[TRACE_CACHE_SIZE];
+
+static inline size_t mixPointer(uintptr_t value) {
+    // Code addresses are at least 4 byte aligned and clustered, so mix the bits before using them as an index
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    return value;
+}
+
+/// @brief Inserts the provided entry into the table, unless an entry for the same key already exists.
+/// Returns the entry for the key, or nullptr if the table is full.
+template<typename T, size_t N, typename K>
+static T const* publish(std::atomic<T const*> (&table)[N], uintptr_t key, K getKey, T const* entry) {
+    for (size_t i = 0, idx = mixPointer(key) & (N - 1); i < N; i++, idx = (idx + 1) & (N - 1)) {
+        T const* existing = nullptr;
+        if (table[idx].compare_exchange_strong(existing, entry, std::memory_order_acq_rel, std::memory_order_acquire)) return entry;
+        if (getKey(existing) == key) {
+            // Lost the race to another thread resolving the same key
+            delete entry;
+            return existing;
+        }
+    }
+    return nullptr;
+}
+
+template<typename T, size_t N, typename K>
+static T const* lookup(std::atomic<T const*> (&table)[N], uintptr_t key, K getKey) {
+    for (size_t i = 0, idx = mixPointer(key) & (N - 1); i < N; i++, idx = (idx + 1) & (N - 1)) {
+        auto* existing = table[idx].load(std::memory_order_acquire);
+        if (!existing) return nullptr;
+        if (getKey(existing) == key) return existing;
+    }
+    return nullptr;
+}
+
+static std::string readBuildId(uintptr_t base) {
+    struct Search {
+        uintptr_t base;
+        std::string buildId;
+    } search{ base, {} };
+    dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) {
+        auto* search = reinterpret_cast<Search*>(data);
+        bool contained = false;
+        for (int i = 0; i < info->dlpi_phnum; i++) {
+            auto const& phdr = info->dlpi_phdr[i];
+            auto start = info->dlpi_addr + phdr.p_vaddr;
+            if (phdr.p_type == PT_LOAD && search->base >= start && search->base < start + phdr.p_memsz) {
+                contained = true;
+                break;
+            }
+        }
+        if (!contained) return 0;
+        for (int i = 0; i < info->dlpi_phnum; i++) {
+            auto const& phdr = info->dlpi_phdr[i];
+            if (phdr.p_type != PT_NOTE) continue;
+            auto* note = reinterpret_cast<uint8_t const*>(info->dlpi_addr + phdr.p_vaddr);
+            auto* end = note + phdr.p_memsz;
+            while (note + sizeof(ElfW(Nhdr)) <= end) {
+                auto* header = reinterpret_cast<ElfW(Nhdr) const*>(note);
+                auto* name = note + sizeof(ElfW(Nhdr));
+                auto* desc = name + ((header->n_namesz + 3) & ~3);
+                if (header->n_type == NT_GNU_BUILD_ID && header->n_namesz == 4 && memcmp(name, "GNU", 4) == 0) {
+                    search->buildId.reserve(header->n_descsz * 2);
+                    for (size_t j = 0; j < header->n_descsz; j++) {
+                        fmt::format_to(std::back_inserter(search->buildId), "{:02x}", desc[j]);
+                    }
+                    return 1;
+                }
+                note = desc + ((header->n_descsz + 3) & ~3);
+            }
+        }
+        return 1;
+    }, &search);
+    return search.buildId;
+}
+
+static std::string_view moduleBuildId(uintptr_t base) {
+    auto getKey = [](ModuleEntry const* entry) { return entry->base; };
+    if (auto* entry = lookup(moduleCache, base, getKey)) return entry->buildId;
+    auto* entry = new ModuleEntry{ base, readBuildId(base) };
+    if (auto* published = publish(moduleCache, base, getKey, entry)) return published->buildId;
+    // The table is full, which would take hundreds of loaded modules, so simply leak the entry
+    return entry->buildId;
+}
+
+SymbolInfo const& symbolize(void const* addr) {
+    auto getKey = [](SymbolInfo const* entry) { return reinterpret_cast<uintptr_t>(entry->addr); };
+    if (auto* entry = lookup(symbolCache, reinterpret_cast<uintptr_t>(addr), getKey)) return *entry;
+
+    auto* result = new SymbolInfo{ addr, nullptr, 0, 0, {}, {}, 0 };
+    Dl_info info;
+    if (dladdr(addr, &info)) {
+        result->module = info.dli_fname;
+        result->moduleBase = reinterpret_cast<uintptr_t>(info.dli_fbase);
+        result->offset = reinterpret_cast<uintptr_t>(addr) - result->moduleBase;
+        result->buildId = moduleBuildId(result->moduleBase);
+        if (info.dli_sname) {
+            result->symbolOffset = reinterpret_cast<uintptr_t>(addr) - reinterpret_cast<uintptr_t>(info.dli_saddr);
+            int status;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            if (status == 0) {
+                result->symbol = demangled;
+                free(demangled);
+            } else {
+                result->symbol = info.dli_sname;
+            }
+        }
+    }
+    if (auto* published = publish(symbolCache, reinterpret_cast<uintptr_t>(addr), getKey, result)) return *published;
+    // The table is full, so hand out a per-thread entry rather than leaking one per call
+    static thread_local SymbolInfo scratch{};
+    scratch = std::move(*result);
+    delete result;
+    return scratch;
+}
+
+TraceRecord recordBacktrace(void* const* frames, uint16_t size) {
+    // FNV-1a over the frame addresses
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (uint16_t i = 0; i < size; i++) {
+        hash ^= reinterpret_cast<uintptr_t>(frames[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    // 0 marks an empty slot
+    if (hash == 0) hash = 1;
+    for (size_t i = 0, idx = mixPointer(hash) & (TRACE_CACHE_SIZE - 1); i < TRACE_CACHE_SIZE; i++, idx = (idx + 1) & (TRACE_CACHE_SIZE - 1)) {
+        auto& entry = traceCache[idx];
+        uint64_t existing = entry.hash.load(std::memory_order_acquire);
+        if (existing == 0 && entry.hash.compare_exchange_strong(existing, hash, std::memory_order_acq_rel)) existing = hash;
+        if (existing == hash) {
+            return { hash, entry.count.fetch_add(1, std::memory_order_relaxed) + 1 };
+        }
+    }
+    return { hash, 0 };
+}
 }  // namespace backtrace_helpers
 
 